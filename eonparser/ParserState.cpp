@@ -5,6 +5,21 @@ namespace eon
 {
 	namespace parser
 	{
+		std::shared_ptr<source::Raw> State::_openFile( const path& input_file, bool memory_map )
+		{
+			if( memory_map )
+			{
+				try
+				{
+					return std::make_shared<source::MappedFile>( input_file.str() );
+				}
+				catch( source::NotMappable& )
+				{
+				}
+			}
+			return std::make_shared<source::File>( input_file.str() );
+		}
+
 		void State::_initialize( source::Reporter& reporter )
 		{
 			Tokenizer tokenizer;
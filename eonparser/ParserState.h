@@ -6,6 +6,7 @@
 #include <eonexpression/Expression.h>
 #include <eonsource/String.h>
 #include <eonsource/File.h>
+#include <eonsource/MappedFile.h>
 #include <eonfilesys/Path.h>
 #include <eontokenizer/TokenParser.h>
 #include <eontokenizer/Tokenizer.h>
@@ -58,8 +59,11 @@ namespace eon
 
 			inline explicit State( string&& input_string, source::Reporter& reporter ) {
 				Source = std::make_shared<source::String>( "string", std::move( input_string ) ); _initialize( reporter ); }
-			inline explicit State( path input_file, source::Reporter& reporter ) {
-				Source = std::make_shared<source::File>( input_file.str() ); _initialize( reporter ); }
+			// Construct for an input file.
+			// If 'memory_map' is true, the file will be memory mapped if
+			// possible, falling back to stream reading for pipes etc.
+			inline explicit State( path input_file, source::Reporter& reporter, bool memory_map = true ) {
+				Source = _openFile( input_file, memory_map ); _initialize( reporter ); }
 
 
 
@@ -70,6 +74,7 @@ namespace eon
 			//
 		private:
 
+			static std::shared_ptr<source::Raw> _openFile( const path& input_file, bool memory_map );
 			void _initialize( source::Reporter& reporter );
 			void _prepTokenizer( Tokenizer& tokenizer );
 			void _prepReTokenizer( ReTokenizer& retokenizer );
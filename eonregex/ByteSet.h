@@ -0,0 +1,76 @@
+#pragma once
+
+#include "RxDefs.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// The 'eon' namespace encloses all public functionality
+//
+namespace eon
+{
+	///////////////////////////////////////////////////////////////////////////
+	//
+	// The 'eon::rx' namespace enclosed special elements for Eon regular
+	// expressions
+	//
+	namespace rx
+	{
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Set of ASCII bytes, for fast scanning of UTF-8 text
+		//
+		// The set is a 128-bit bitmap, stored as 16 rows (one for each low
+		// nibble) with one bit for each high nibble. This is the layout used
+		// by the vector lookup, which classifies 16 bytes at a time.
+		//
+		// Non-ASCII bytes are either all in the set or all outside of it,
+		// see [nonAscii].
+		//
+		class ByteSet
+		{
+		public:
+			ByteSet() = default;
+
+			// Add a byte, any non-ASCII byte adds all non-ASCII bytes
+			inline void set( byte_t byte ) noexcept {
+				if( byte < 128 ) Rows[ byte & 0x0F ] |= static_cast<byte_t>( 1 << ( byte >> 4 ) ); else NonAscii = true; }
+
+			// Remove all bytes
+			inline void clear() noexcept { for( auto& row : Rows ) row = 0; NonAscii = false; }
+
+			// Check if an ASCII character is in the set
+			inline bool ascii( char_t chr ) const noexcept { return ( Rows[ chr & 0x0F ] >> ( chr >> 4 ) ) & 1; }
+
+			// Check if non-ASCII bytes are in the set
+			inline bool nonAscii() const noexcept { return NonAscii; }
+
+			// Check if a byte is in the set
+			inline bool operator[]( byte_t byte ) const noexcept { return byte < 128 ? ascii( byte ) : NonAscii; }
+
+			// Check if the set is empty
+			inline bool empty() const noexcept {
+				for( auto row : Rows ) { if( row != 0 ) return false; } return !NonAscii; }
+
+			inline bool operator==( const ByteSet& other ) const noexcept {
+				for( int i = 0; i < 16; ++i ) { if( Rows[ i ] != other.Rows[ i ] ) return false; }
+				return NonAscii == other.NonAscii; }
+			inline bool operator!=( const ByteSet& other ) const noexcept { return !( *this == other ); }
+
+
+			// Find the first byte in the set, 'end' if none.
+			const char* findFirstIn( const char* begin, const char* end ) const noexcept;
+
+			// Find the first byte that is not in the set, or that is not ASCII
+			// (regardless of [nonAscii]). Returns 'end' if none.
+			const char* findFirstNotIn( const char* begin, const char* end ) const noexcept;
+
+		private:
+			const char* _findFirst( const char* begin, const char* end, bool in ) const noexcept;
+
+		private:
+			byte_t Rows[ 16 ]{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+			bool NonAscii{ false };
+		};
+	}
+}
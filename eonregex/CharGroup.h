@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Node.h"
+#include "ByteSet.h"
 #include <unordered_set>
 
 
@@ -19,6 +20,10 @@ namespace eon
 	{
 		// Value node
 		// Matches a character group
+		//
+		// The group is compiled when constructed: ASCII characters are looked
+		// up in a bitmap (with case folding and negation applied), other
+		// characters are binary searched in a sorted table of ranges.
 		class CharGroup : public Node
 		{
 		public:
@@ -50,20 +55,33 @@ namespace eon
 			inline CharGroup( const substring& source ) : Node( source ) { Type = NodeType::val_chargroup; }
 			inline CharGroup( const CharGroup& other ) { *this = other; }
 			inline CharGroup( CharGroup&& other ) noexcept { *this = std::move( other ); }
-			inline CharGroup( CharGrp&& value, const substring& source ) : Node( source ) {
-				Type = NodeType::val_chargroup; Value = std::move( value ); }
+			inline CharGroup( CharGrp&& value, const substring& source, bool icase ) : Node( source ) {
+				Type = NodeType::val_chargroup; Value = std::move( value ); _compile( icase ); }
 			virtual ~CharGroup() = default;
 
 			inline Node* copy() const override { return new CharGroup( *this ); }
 
 			inline CharGroup& operator=( const CharGroup& other ) {
-				*static_cast<Node*>( this ) = other; Value = other.Value; return *this; }
+				*static_cast<Node*>( this ) = other; Value = other.Value; Ascii = other.Ascii; Table = other.Table;
+				ICase = other.ICase; FoldMisses = other.FoldMisses; return *this; }
 			inline CharGroup& operator=( CharGroup&& other ) noexcept {
-				*static_cast<Node*>( this ) = std::move( other ); Value = std::move( other.Value ); return *this; }
+				*static_cast<Node*>( this ) = std::move( other ); Value = std::move( other.Value ); Ascii = other.Ascii;
+				Table = std::move( other.Table ); ICase = other.ICase; FoldMisses = other.FoldMisses; return *this; }
+
+			// Get the ASCII characters matched by the group (non-ASCII
+			// characters may or may not match)
+			inline const ByteSet& ascii() const noexcept { return Ascii; }
 
 		private:
-			bool _match( RxData& data, index_t steps ) override;
-			bool _match( char_t chr );
+			bool _match( RxData& data, index_t steps ) const override;
+			bool _matchNonAscii( char_t chr ) const;
+			bool _inTable( char_t chr ) const noexcept;
+			bool _matchSpecial( char_t chr ) const;
+
+			// Match as parsed, without case folding and negation
+			bool _matchRaw( char_t chr ) const;
+
+			void _compile( bool icase );
 
 			inline string _strStruct() const override { return Value.str(); }
 
@@ -74,6 +92,11 @@ namespace eon
 
 		private:
 			CharGrp Value;
+
+			ByteSet Ascii;
+			std::vector<std::pair<char_t, char_t>> Table;	// Sorted, non-overlapping, non-ASCII only
+			bool ICase{ false };
+			bool FoldMisses{ false };		// Case fold characters not found (at match time)
 		};
 	}
 }
@@ -0,0 +1,236 @@
+#pragma once
+
+#include "RxDefs.h"
+#include "RxData.h"
+#include "Node.h"
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// The 'eon' namespace encloses all public functionality
+//
+namespace eon
+{
+	///////////////////////////////////////////////////////////////////////////
+	//
+	// The 'eon::rx' namespace enclosed special elements for Eon regular
+	// expressions
+	//
+	namespace rx
+	{
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Lazy DFA engine
+		//
+		// A graph (see [eon::rx::Graph]) without backreferences, negations,
+		// word boundaries, named value checks, or line/word/space anchoring
+		// can be compiled into an NFA (Thompson construction). The NFA is
+		// executed as a DFA, where each DFA state is a set of NFA states.
+		// DFA states and their transitions are created on demand and cached,
+		// so matching runs in linear time with constant work per character
+		// (once warm), no matter how pathological the expression.
+		//
+		// The engine knows where matches end, but not what the captures are.
+		// The graph uses it:
+		//   1. As a prefilter, to reject inputs and start positions that
+		//      cannot match before running the backtracking matcher.
+		//   2. As the sole matcher when the 'd' flag is set. Matches are then
+		//      leftmost-longest, and only the complete match is captured.
+		// Graphs can also be combined into one engine, to find which of them
+		// match in a single pass (see [eon::rx::regex_set]).
+		//
+		// NOTE: The caches are taken from a pool for each call, so the same
+		//       engine can be used from multiple threads at the same time!
+		//
+		class Dfa
+		{
+		public:
+			Dfa() = default;
+			Dfa( const Dfa& ) = delete;
+			Dfa( Dfa&& ) = delete;
+			virtual ~Dfa() = default;
+
+			Dfa& operator=( const Dfa& ) = delete;
+			Dfa& operator=( Dfa&& ) = delete;
+
+			// Compile the graph starting at 'head'.
+			// Returns false if the graph uses features not supported by the
+			// engine (or is too big), and the engine cannot be used.
+			bool compile( const Node& head, Flag flags );
+
+			// Add another graph, matched as an alternative to those already
+			// added (see [eon::rx::regex_set]). Matches of the graph are
+			// reported as 'pattern'.
+			// Returns false if the graph cannot be added, the engine is then
+			// unchanged.
+			bool add( const Node& head, Flag flags, uint32_t pattern );
+
+
+			// Get number of NFA states
+			inline index_t numNfaStates() const noexcept { return static_cast<index_t>( Nfa.size() ); }
+
+			// Get number of graphs (patterns) added
+			inline index_t numPatterns() const noexcept { return NumPatterns; }
+
+			// Find the (UTF-8) bytes that a match can start with, all
+			// non-ASCII lead bytes are included if any non-ASCII character can.
+			// Returns false if a match can be empty (and start anywhere).
+			bool firstBytes( std::array<bool, 256>& bytes ) const;
+
+
+
+
+			///////////////////////////////////////////////////////////////////
+			//
+			// Matching
+			//
+		private:
+			struct Cache;
+		public:
+
+			// Runs the engine, using a cache (of DFA states) taken from the
+			// engine's pool for as long as the runner lives.
+			class Runner
+			{
+			public:
+				Runner() = delete;
+				explicit Runner( const Dfa& dfa );
+				Runner( const Runner& ) = delete;
+				Runner( Runner&& ) = delete;
+				~Runner();
+
+				Runner& operator=( const Runner& ) = delete;
+				Runner& operator=( Runner&& ) = delete;
+
+				// Match from the start of 'str'.
+				// If 'longest', 'end' is set to the end of the longest match,
+				// otherwise to the end of the first (shortest) match found.
+				// Returns false if no match.
+				bool matchEnd( const substring& str, bool longest, string_iterator& end );
+
+				// Check if there is a match anywhere within 'str'
+				bool search( const substring& str );
+
+				// Find all patterns with a match anywhere within 'str',
+				// setting 'found[pattern]' for each ('found' must have room
+				// for all patterns). Stops as soon as all have been found.
+				// Returns number of patterns found.
+				index_t searchAll( const substring& str, std::vector<bool>& found );
+
+			private:
+				const Dfa& Engine;
+				std::unique_ptr<Cache> Item;
+			};
+
+
+
+
+			///////////////////////////////////////////////////////////////////
+			//
+			// Internals
+			//
+		private:
+			struct NfaState
+			{
+				enum class kind : uint8_t
+				{
+					chr,		// Match 'Chr'
+					pred,		// Match a value node
+					split,		// Continue to both 'Out1' and 'Out2'
+					start,		// Pass only at the start of the input
+					end,		// Pass only at the end of the input
+					accept		// Match!
+				};
+				kind Kind{ kind::accept };
+				char_t Chr{ 0 };
+				const Node* Pred{ nullptr };
+				uint32_t Out1{ 0 }, Out2{ 0 };
+				Flag Flags{ Flag::none };	// Flags of the graph
+				uint32_t Pattern{ 0 };		// For 'accept': Which graph
+
+				// For 'pred': Which ASCII characters match, and if it matches
+				// (without consuming anything) at the end of input
+				std::bitset<128> Ascii;
+				bool AtEnd{ false };
+			};
+
+			using nfaset = std::vector<uint32_t>;
+
+			struct DfaState
+			{
+				DfaState() { std::fill( Ascii, Ascii + 128, Unknown ); }
+
+				nfaset Nfa;
+				bool Accepting{ false };
+				int8_t AcceptAtEnd{ -1 };		// -1 when not determined yet
+				std::vector<uint32_t> Patterns;		// Accepted patterns
+				std::vector<uint32_t> PatternsAtEnd;	// Determined with 'AcceptAtEnd'
+				uint32_t Ascii[ 128 ];
+				std::unordered_map<char_t, uint32_t> Other;
+			};
+
+			// All states and transitions built while matching, owned by one
+			// thread at a time.
+			struct Cache
+			{
+				void clear();
+
+				std::vector<std::unique_ptr<DfaState>> States;
+				std::map<nfaset, uint32_t> Ids;
+				uint32_t Start[ 2 ][ 2 ];	// [searching][at start of input]
+
+				// Scratch space for closure calculations
+				std::vector<uint32_t> Visited;
+				uint32_t Generation{ 0 };
+				std::vector<uint32_t> Stack;
+			};
+
+			uint32_t _add( NfaState::kind kind, uint32_t out1 = 0, uint32_t out2 = 0 );
+			bool _compileChain( const Node* node, uint32_t next, uint32_t& entry );
+			bool _compileNode( const Node& node, uint32_t next, uint32_t& entry );
+			bool _compileBody( const Node& node, uint32_t next, uint32_t& entry );
+			bool _compilePred( const Node& node, uint32_t next, uint32_t& entry );
+
+			bool _accepts( const NfaState& state, char_t c ) const;
+			bool _matchPred( const Node& node, char_t c, Flag flags ) const;
+
+			void _closure( Cache& cache, uint32_t nfa_state, bool at_start, nfaset& states ) const;
+			uint32_t _state( Cache& cache, nfaset&& states, bool searching ) const;
+			uint32_t _start( Cache& cache, bool searching, bool at_start ) const;
+			uint32_t _step( Cache& cache, uint32_t state, char_t c ) const;
+			bool _acceptAtEnd( Cache& cache, uint32_t state ) const;
+			void _nextGeneration( Cache& cache ) const noexcept;
+
+
+
+
+			///////////////////////////////////////////////////////////////////
+			//
+			// Attributes
+			//
+		private:
+			static constexpr uint32_t Unknown{ UINT32_MAX };
+			static constexpr uint32_t Dead{ 0 };
+			static constexpr uint32_t Searching{ UINT32_MAX };	// Marks DFA states used for searching
+
+			// Limits
+			static constexpr index_t MaxNfaStates{ 10000 };
+			static constexpr index_t MaxDfaStates{ 2000 };		// Cache is cleared when reached
+
+			std::vector<NfaState> Nfa;
+			uint32_t Entry{ 0 };
+			index_t NumPatterns{ 0 };
+			Flag Flags{ Flag::none };	// Of the graph being compiled
+
+			mutable std::mutex PoolLock;
+			mutable std::vector<std::unique_ptr<Cache>> Pool;
+		};
+	}
+}
@@ -4,7 +4,10 @@
 #include "RxData.h"
 #include "Node.h"
 #include "CharGroup.h"
+#include "ByteSet.h"
 #include "OpOr.h"
+#include "Dfa.h"
+#include "LiteralMatcher.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -31,7 +34,9 @@ namespace eon
 			Graph& operator=( const Graph& other );
 			Graph& operator=( Graph&& other ) noexcept;
 
-			inline void clear() noexcept { if( Head != nullptr ) { delete Head; Head = nullptr; } }
+			inline void clear() noexcept {
+				if( Head != nullptr ) { delete Head; Head = nullptr; } Automaton.reset(); Literal.reset(); Captures.reset();
+				Prefix.clear(); Required.clear(); HasFirstBytes = false; AnchoredStart = false; }
 
 			void parse( substring source, substring flags );
 
@@ -39,12 +44,51 @@ namespace eon
 
 			inline bool empty() const noexcept { return Head == nullptr; }
 
+			// Get the first node, nullptr if empty
+			inline const Node* head() const noexcept { return Head; }
+
+			// Match the graph against 'param', which must have been created
+			// with a [eon::rx::MatchContext] for [numNodes] nodes.
+			// NOTE: The graph is never modified by matching, so it can be
+			//       matched from multiple threads at the same time!
 			inline bool match( RxData& param ) const {
-				if( Head ) { Head->_unmatch(); return Head->match( param ); } else return false; }
+				if( Head ) { Head->_unmatch( param.context() ); return Head->match( param ); } else return false; }
+
+			// Get number of nodes in the graph
+			inline index_t numNodes() const noexcept { return NumNodes; }
+
+			// Get the capture slots of the graph
+			inline const std::shared_ptr<const CaptureSlots>& captureSlots() const noexcept { return Captures; }
+
+			// Get the DFA engine for the graph, nullptr if the graph cannot
+			// be matched by DFA (or the 'no_dfa' flag is set)
+			inline const Dfa* dfa() const noexcept { return Automaton.get(); }
+
+			// Get the specialized matcher for literal expressions, nullptr
+			// if not a literal expression (or the 'no_literal' flag is set)
+			inline const LiteralMatcher* literalMatcher() const noexcept { return Literal.get(); }
+
+			// Literal prefilter, for skipping ahead to where a match can start
+			// (all empty/nullptr/false if nothing is known, or the
+			// 'no_prefilter' flag is set)
+
+			// Literal that every match starts with
+			inline const string& prefix() const noexcept { return Prefix; }
+
+			// Literal that every match contains
+			inline const string& required() const noexcept { return Required; }
+
+			// Set of the UTF-8 bytes that a match can start with
+			inline const ByteSet* firstBytes() const noexcept { return HasFirstBytes ? &FirstBytes : nullptr; }
+
+			// Check if every match must be at the start of the input
+			inline bool anchoredStart() const noexcept { return AnchoredStart; }
 
 			inline const substring& source() const noexcept { return Source; }
 			
-			inline string strStruct() const { return Head ? Head->strStruct() : string(); }
+			// Get the complete (optimized) pattern, prefixed by "[literal]" or
+			// "[literal set]" if matched by the specialized literal matcher
+			string strStruct() const;
 
 		private:
 			void parse();
@@ -129,6 +173,8 @@ namespace eon
 			void _removeSuperfluousGroups() noexcept;
 			void _exposeLiterals();
 			void _failFastFixedEnd();
+			void _finalize();
+			void _findLiterals();
 
 
 
@@ -137,6 +183,15 @@ namespace eon
 			substring Source;
 			Node* Head{ nullptr };
 			Flag MyFlags{ Flag::none };
+			index_t NumNodes{ 0 };
+			std::shared_ptr<const CaptureSlots> Captures;
+			std::unique_ptr<Dfa> Automaton;
+			std::unique_ptr<LiteralMatcher> Literal;
+
+			string Prefix, Required;
+			ByteSet FirstBytes;
+			bool HasFirstBytes{ false };
+			bool AnchoredStart{ false };
 		};
 	}
 }
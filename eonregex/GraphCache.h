@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Graph.h"
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// The 'eon' namespace encloses all public functionality
+//
+namespace eon
+{
+	///////////////////////////////////////////////////////////////////////////
+	//
+	// The 'eon::rx' namespace enclosed special elements for Eon regular
+	// expressions
+	//
+	namespace rx
+	{
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Process-wide cache of parsed expressions
+		//
+		// Parsing (and optimizing) an expression is much more costly than
+		// looking it up. Every [eon::regex] gets its graph from here, keyed
+		// by pattern and flags. The graphs are never modified after parsing,
+		// so they are shared by all regex objects for the same expression.
+		//
+		// The least recently used graphs are dropped from the cache when it
+		// is full, the regex objects using them keep them alive.
+		//
+		// NOTE: The cache can be used from multiple threads at the same time!
+		//
+		class GraphCache
+		{
+		public:
+			GraphCache() = default;
+			GraphCache( const GraphCache& ) = delete;
+			GraphCache( GraphCache&& ) = delete;
+			virtual ~GraphCache() = default;
+
+			GraphCache& operator=( const GraphCache& ) = delete;
+			GraphCache& operator=( GraphCache&& ) = delete;
+
+
+			// Get the process-wide cache
+			static GraphCache& get();
+
+
+			// Get graph for 'pattern' and 'flags', parsing it if not cached.
+			// WARNING: Throws [eon::rx::InvalidExpression] if the pattern or
+			//          flags are invalid (and nothing is cached)!
+			std::shared_ptr<const Graph> graph( const string& pattern, const string& flags );
+
+
+			// Set max number of cached graphs, zero disables the cache
+			void capacity( index_t max_graphs );
+
+			// Get max number of cached graphs
+			index_t capacity() const;
+
+			// Get number of cached graphs
+			index_t size() const;
+
+			// Remove all cached graphs
+			void clear();
+
+
+			// Get number of times a graph was found in the cache
+			inline index_t hits() const noexcept { return Hits; }
+
+			// Get number of times a graph had to be parsed
+			inline index_t misses() const noexcept { return Misses; }
+
+
+
+
+			///////////////////////////////////////////////////////////////////
+			//
+			// Internals
+			//
+		private:
+
+			// The graph refers to the pattern, so they are kept together
+			struct Entry
+			{
+				string Pattern, Flags;
+				Graph Expression;
+			};
+			using lru_t = std::list<std::pair<std::string, std::shared_ptr<const Entry>>>;
+
+			static std::string _key( const string& pattern, const string& flags );
+			void _trim();
+
+		private:
+			mutable std::mutex Lock;
+			lru_t Lru;		// Most recently used first
+			std::unordered_map<std::string, lru_t::iterator> Index;
+			index_t Capacity{ 1000 };
+
+			std::atomic<index_t> Hits{ 0 }, Misses{ 0 };
+		};
+	}
+}
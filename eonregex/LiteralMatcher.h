@@ -0,0 +1,118 @@
+#pragma once
+
+#include "RxDefs.h"
+#include "Node.h"
+#include "ByteSet.h"
+#include <string_view>
+#include <unordered_map>
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// The 'eon' namespace encloses all public functionality
+//
+namespace eon
+{
+	///////////////////////////////////////////////////////////////////////////
+	//
+	// The 'eon::rx' namespace enclosed special elements for Eon regular
+	// expressions
+	//
+	namespace rx
+	{
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Specialized matcher for literal expressions
+		//
+		// A graph (see [eon::rx::Graph]) that is just a fixed string, or
+		// alternatives of fixed strings, optionally anchored to the start
+		// and/or end of input (and without flags 'i' and 'l'), is matched by
+		// comparing bytes instead of walking the graph:
+		//   1. A single literal is compared using memcmp and searched for
+		//      using std::string_view::find.
+		//   2. Alternatives are looked up in a hash table, once for each
+		//      length of literal, at each position that starts with one of
+		//      their first bytes.
+		//
+		// Results are the same as by the graph: The first alternative that
+		// matches wins (the longest if flag 'd' is set).
+		//
+		// NOTE: The input must be valid UTF-8!
+		//
+		class LiteralMatcher
+		{
+		public:
+			LiteralMatcher() = default;
+			LiteralMatcher( const LiteralMatcher& ) = delete;
+			LiteralMatcher( LiteralMatcher&& ) = delete;
+			virtual ~LiteralMatcher() = default;
+
+			LiteralMatcher& operator=( const LiteralMatcher& ) = delete;
+			LiteralMatcher& operator=( LiteralMatcher&& ) = delete;
+
+			// Compile the graph starting at 'head'.
+			// Returns false if the graph is not a literal expression, and
+			// the matcher cannot be used.
+			bool compile( const Node& head, Flag flags );
+
+
+			// Check if a single literal (and not alternatives)
+			inline bool single() const noexcept { return Values.size() == 1; }
+
+
+			// A match, as start and end bytes and number of characters
+			struct Found
+			{
+				const char* Begin{ nullptr };
+				const char* End{ nullptr };
+				index_t NumChars{ 0 };
+
+				inline explicit operator bool() const noexcept { return Begin != nullptr; }
+			};
+
+			// Match at 'pos', where 'end' is the end of input and 'at_start'
+			// tells if 'pos' is the start of the input.
+			Found match( const char* pos, const char* end, bool at_start ) const noexcept;
+
+			// Find the first match from 'begin', where 'end' is the end of
+			// input and 'at_start' tells if 'begin' is the start of input.
+			Found findFirst( const char* begin, const char* end, bool at_start ) const noexcept;
+
+
+
+
+			///////////////////////////////////////////////////////////////////
+			//
+			// Internals
+			//
+		private:
+			struct Value
+			{
+				std::string Bytes;
+				index_t NumChars{ 0 };
+			};
+
+			bool _add( const Node& node );
+
+			// Match at 'pos' (ignoring start anchoring)
+			Found _match( const char* pos, const char* end ) const noexcept;
+
+
+
+
+			///////////////////////////////////////////////////////////////////
+			//
+			// Attributes
+			//
+		private:
+			std::vector<Value> Values;							// In order of alternatives
+			std::unordered_map<std::string_view, index_t> Index;	// Value to (first) alternative
+			std::vector<size_t> Lengths;							// Distinct, shortest first
+			ByteSet FirstBytes;
+
+			bool AtStart{ false };		// Must match at start of input
+			bool AtEnd{ false };		// Must match at end of input
+			bool Longest{ false };		// Longest alternative wins (flag 'd')
+		};
+	}
+}
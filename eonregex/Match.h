@@ -1,5 +1,7 @@
 #pragma once
 #include "RxDefs.h"
+#include "RxData.h"
+#include <memory>
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -38,10 +40,12 @@ namespace eon
 			// Take ownership of the 'other' match
 			inline match( match&& other ) noexcept { *this = std::move( other ); }
 
-			// Construct from a map of [eon::name_t] to [eon::substring]
-			inline match( captures_t* captures ) noexcept { Captures = captures; }
+			// Construct from captures indexed by the slots of 'names'
+			// (where slot 0, the complete match, must be set)
+			inline match( std::vector<substring>&& captures, const std::shared_ptr<const CaptureSlots>& names ) noexcept {
+				Captures = std::move( captures ); Names = names; }
 
-			inline virtual ~match() { clear(); }
+			inline virtual ~match() = default;
 
 
 
@@ -53,15 +57,15 @@ namespace eon
 
 			// Copy the 'other' match
 			inline match& operator=( const match& other ) {
-				clear(); if( other.Captures ) Captures = new captures_t( *other.Captures ); return *this; }
+				Captures = other.Captures; Names = other.Names; return *this; }
 
 			// Take ownership of the details of the 'other' match
 			inline match& operator=( match&& other ) noexcept {
-				clear(); if( other.Captures ) { Captures = other.Captures; other.Captures = nullptr; } return *this; }
+				Captures = std::move( other.Captures ); Names = std::move( other.Names ); return *this; }
 
 
 			// Clear this match
-			inline void clear() noexcept { if( Captures ) { delete Captures; Captures = nullptr; } }
+			inline void clear() noexcept { Captures.clear(); Names.reset(); }
 
 
 
@@ -72,29 +76,52 @@ namespace eon
 			//
 
 			// Check if there was a match
-			inline operator bool() const noexcept { return Captures; }
+			inline operator bool() const noexcept { return !Captures.empty(); }
 
 			// Get number of captures (including the entire match)
-			inline index_t size() const noexcept { return Captures ? Captures->size() : 0; }
+			inline index_t size() const noexcept {
+				index_t num = 0; for( auto& capture : Captures ) { if( capture.hasSource() ) ++num; } return num; }
 
 			// Get the entire match
-			inline substring all() const noexcept { return group( name_complete ); }
+			inline substring all() const noexcept { return Captures.empty() ? substring() : Captures[ 0 ]; }
 
 			// Get a capture
-			inline substring group( const name_t name ) const noexcept { if( !Captures ) return substring();
-				auto found = Captures->find( name ); return found != Captures->end() ? found->second : substring(); }
+			inline substring group( const name_t name ) const noexcept { if( !Names ) return substring();
+				auto slot = Names->find( name ); return slot < Captures.size() ? Captures[ slot ] : substring(); }
 
-			using iterator = captures_t::const_iterator;
-			inline iterator begin() const noexcept { return Captures ? Captures->begin() : iterator(); }
-			inline iterator end() const noexcept { return Captures ? Captures->end() : iterator(); }
 
+			// Iterate the captures as pairs of name and [eon::substring]
+			class iterator
+			{
+			public:
+				iterator() = default;
+				inline iterator( const match& owner, index_t slot ) noexcept { Owner = &owner; Slot = slot; _skip(); }
 
+				inline std::pair<name_t, substring> operator*() const {
+					return std::make_pair( Owner->Names->name( Slot ), Owner->Captures[ Slot ] ); }
+				inline iterator& operator++() noexcept { ++Slot; _skip(); return *this; }
 
+				inline bool operator==( const iterator& other ) const noexcept {
+					return Owner == other.Owner && Slot == other.Slot; }
+				inline bool operator!=( const iterator& other ) const noexcept { return !( *this == other ); }
+
+			private:
+				inline void _skip() noexcept {
+					while( Slot < Owner->Captures.size() && !Owner->Captures[ Slot ].hasSource() ) ++Slot; }
+
+			private:
+				const match* Owner{ nullptr };
+				index_t Slot{ 0 };
+			};
+			inline iterator begin() const noexcept { return iterator( *this, 0 ); }
+			inline iterator end() const noexcept { return iterator( *this, Captures.size() ); }
 
-		private:
-			captures_t* Captures{ nullptr };
 
-			friend class RegEx;
+
+
+		private:
+			std::vector<substring> Captures;
+			std::shared_ptr<const CaptureSlots> Names;
 		};
 	}
 }
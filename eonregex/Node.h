@@ -19,6 +19,8 @@ namespace eon
 	//
 	namespace rx
 	{
+		class ByteSet;
+
 		// Super-class for all operators, locations and values
 		class Node
 		{
@@ -39,7 +41,9 @@ namespace eon
 			inline NodeType type() const noexcept { return Type; }
 			inline bool open() const noexcept { return Open; }
 
-			bool match( RxData& data, index_t steps = nsize );
+			// Match against 'data', keeping all match state in 'data.context()'.
+			// NOTE: The node itself is not modified!
+			bool match( RxData& data, index_t steps = nsize ) const;
 
 
 			// Get node structure as a string
@@ -72,7 +76,7 @@ namespace eon
 			void combineFixed();
 
 		protected:
-			virtual bool _match( RxData& data, index_t steps ) = 0;
+			virtual bool _match( RxData& data, index_t steps ) const = 0;
 
 			virtual string _strStruct() const { return string(); }
 
@@ -81,7 +85,9 @@ namespace eon
 			virtual void _combinedFixed() {}
 
 			using Stack = stack<RxData>;
-			inline Stack _stack() { Stack data; data.reserve( 53 ); return data; }
+			inline Stack _stack() const { Stack data; data.reserve( 53 ); return data; }
+
+			inline NodeState& _state( const RxData& data ) const noexcept { return data.context().state( Id ); }
 
 		public:
 			virtual index_t _countMinCharsRemaining() noexcept = 0;
@@ -89,32 +95,44 @@ namespace eon
 				if( Next ) Next = Next->_removeSuperfluousGroups(); return this; }
 			virtual Node* _exposeLiterals() { if( Next ) Next = Next->_exposeLiterals(); return this; }
 			virtual void _failFastFixedEnd( Node& head );
-			inline bool _matched() const noexcept { return static_cast<bool>( Matched.source() ); }
-			virtual void _unmatch() noexcept { if( _matched() ) { Matched = RxData(); if( Next ) Next->_unmatch(); } }
-			virtual void _capture( RxData& data ) {}
+
+			// Number the nodes, resolve capture slots, and set groups, making the
+			// graph ready for matching
+			virtual void _finalize( index_t& num_nodes, CaptureSlots& captures );
+
+			inline bool _matched( MatchContext& context ) const noexcept {
+				return static_cast<bool>( context.state( Id ).Matched.source() ); }
+			virtual void _unmatch( MatchContext& context ) const noexcept {
+				if( _matched( context ) ) { context.state( Id ).Matched = RxData(); if( Next ) Next->_unmatch( context ); } }
+			virtual void _capture( RxData& data ) const {}
+
+			// Count a backtrack, if counting (see [eon::rx::Stats])
+			static inline void _countBacktrack( const RxData& data ) noexcept {
+				if( data.context().counts() ) ++data.context().counts()->Backtracks; }
 
 
 		private:
-			bool _matchSingle( RxData& data, index_t steps );
-			bool _matchOneOrZero( RxData& data, index_t steps );
-			bool _matchRangeGreedy( RxData& data, index_t steps );
-			void _matchMax( Stack& matches, index_t steps );
-			bool _matchSpecialCase( Stack& matches );
-			void _matchAny( Stack& matches );
-			bool _noNext( RxData& data, Stack& matches );
-			bool _matchNext( RxData& data, Stack& matches );
-			bool _matchRangeNongreedy( RxData& data, index_t steps );
+			bool _matchSingle( RxData& data, index_t steps ) const;
+			bool _matchOneOrZero( RxData& data, index_t steps ) const;
+			bool _matchRangeGreedy( RxData& data, index_t steps ) const;
+			void _matchMax( Stack& matches, index_t steps ) const;
+			bool _matchSpecialCase( Stack& matches ) const;
+			void _matchAny( Stack& matches ) const;
+			bool _matchAscii( Stack& matches, const ByteSet& chars ) const;
+			bool _noNext( RxData& data, Stack& matches ) const;
+			bool _matchNext( RxData& data, Stack& matches ) const;
+			bool _matchRangeNongreedy( RxData& data, index_t steps ) const;
 
-			bool _matchNext( RxData& data, index_t steps );
+			bool _matchNext( RxData& data, index_t steps ) const;
 
-			bool _preAnchorMatch( RxData& data );
+			bool _preAnchorMatch( RxData& data ) const;
 
 			inline void _setGroup( Node* node ) noexcept {
 				if( Next ) Next->_setGroup( node ); else Group = node; }
 			inline Node* _next() const noexcept { return Group ? Group->Next : Next; }
 
 		protected:
-			RxData Matched;
+			index_t Id{ 0 };
 			Node* Next{ nullptr };
 			Node* Group{ nullptr };
 			Node* FixedEnd{ nullptr };
@@ -125,9 +143,10 @@ namespace eon
 			substring Source;
 			NodeType Type{ NodeType::undef };
 			Anchor PreAnchoring{ Anchor::none };
-			RecordedPos PrevPos;
 
 			friend class Graph;
+			friend class Dfa;
+			friend class LiteralMatcher;
 			friend class NodeGroup;
 			friend class FixedValue;
 		};
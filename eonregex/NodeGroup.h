@@ -38,7 +38,7 @@ namespace eon
 				Head = other.Head; other.Head = nullptr; return *this; }
 
 		protected:
-			bool _match( RxData& data, index_t steps ) override;
+			bool _match( RxData& data, index_t steps ) const override;
 
 			inline string _strStruct() const override { return Head ? "(" + Head->strStruct() + ")" : "()"; }
 
@@ -53,7 +53,9 @@ namespace eon
 					+ ( Next ? Next->_countMinCharsRemaining() : 0 ); }
 			virtual Node* _removeSuperfluousGroups() noexcept override;
 			void _failFastFixedEnd( Node& head ) override;
-			void _unmatch() noexcept override { if( Head->_matched() ) Head->_unmatch(); Node::_unmatch(); }
+			void _finalize( index_t& num_nodes, CaptureSlots& captures ) override;
+			void _unmatch( MatchContext& context ) const noexcept override {
+				if( Head->_matched( context ) ) Head->_unmatch( context ); Node::_unmatch( context ); }
 
 			void _append( Node* node ) noexcept;
 			inline bool _locked() const noexcept { return _Cur == nullptr; }
@@ -64,6 +66,8 @@ namespace eon
 			Node* _Cur{ (Node*)1 };
 
 			friend class Graph;
+			friend class Dfa;
+			friend class LiteralMatcher;
 		};
 	}
 }
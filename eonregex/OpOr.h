@@ -35,7 +35,7 @@ namespace eon
 				*static_cast<Node*>( this ) = std::move( other ); Optionals = std::move( other.Optionals ); return *this; }
 
 		private:
-			bool _match( RxData& param, index_t steps ) override;
+			bool _match( RxData& param, index_t steps ) const override;
 			inline string _strStruct() const override {
 				string s; for( auto& opt : Optionals ) { if( !s.empty() ) s += "|"; s += opt->strStruct(); } return s; }
 			index_t _countMinCharsRemaining() noexcept override;
@@ -43,13 +43,17 @@ namespace eon
 			inline void _combinedFixed() override { for( auto node : Optionals ) node->combineFixed(); }
 			Node* _removeSuperfluousGroups() noexcept override;
 			void _failFastFixedEnd( Node& head ) override;
-			void _unmatch() noexcept override {
-				for( auto node : Optionals ) { if( node->_matched() ) node->_unmatch(); } Node::_unmatch(); }
+			void _finalize( index_t& num_nodes, CaptureSlots& captures ) override;
+			void _unmatch( MatchContext& context ) const noexcept override {
+				for( auto node : Optionals ) { if( node->_matched( context ) ) node->_unmatch( context ); }
+				Node::_unmatch( context ); }
 
 		private:
 			std::vector<Node*> Optionals;
 
 			friend class Graph;
+			friend class Dfa;
+			friend class LiteralMatcher;
 		};
 	}
 }
@@ -5,49 +5,136 @@ namespace eon
 {
 	rx::match regex::match( const substring& str ) const
 	{
-		if( str.empty() || Graph.empty() )
+		if( str.empty() || !Graph )
 			return rx::match();
+		EON_RX_STATS( rx::CallStats stats( Counters.get(), str.begin() ); )
+		if( Graph->literalMatcher() && str.begin().validUTF8() )
+			return _literalResult( str.begin(), Graph->literalMatcher()->match(
+				str.begin().byteData(), str.end().byteData(), str.begin().numChar() == 0 ) );
+		if( ( Graph->anchoredStart() && str.begin().numChar() > 0 )
+			|| ( !Graph->prefix().empty() && !str.startsWith( Graph->prefix().substr() ) ) )
+		{
+			EON_RX_STATS( ++stats.Counts.Rejected; )
+			return rx::match();
+		}
 
-		rx::RxData data( str, Graph.flags(), ++((regex*)this)->Marker );
-		string::iterator start = data.pos();
-		if( Graph.match( data ) )
+		// The DFA will quickly tell if there is no match, and is the
+		// matcher when flag 'd' is set
+		if( Graph->dfa() )
 		{
-			data.registerCapture( name_complete, substring( start, data.pos() ) );
-			return rx::match( data.claimCaptures() );
+			rx::Dfa::Runner dfa( *Graph->dfa() );
+			string::iterator end;
+			if( !dfa.matchEnd( str, _dfaOnly(), end ) )
+			{
+				EON_RX_STATS( ++stats.Counts.Rejected; )
+				return rx::match();
+			}
+			if( _dfaOnly() )
+				return _result( substring( str.begin(), end ) );
 		}
+
+		rx::MatchContext context( Graph->numNodes() );
+		EON_RX_STATS( context.counts( &stats.Counts ); stats.attempt( str.begin() ); )
+		rx::RxData data( str, Graph->flags(), context );
+		string::iterator start = data.pos();
+		if( Graph->match( data ) )
+			return _result( substring( start, data.pos() ), &data );
 		else
 			return rx::match();
 	}
 
 	rx::match regex::findFirst( const substring& str ) const
 	{
-		if( str.empty() || Graph.empty() )
+		if( str.empty() || !Graph )
 			return rx::match();
+		EON_RX_STATS( rx::CallStats stats( Counters.get(), str.begin() ); )
+		if( Graph->literalMatcher() && str.begin().validUTF8() )
+			return _literalResult( str.begin(), Graph->literalMatcher()->findFirst(
+				str.begin().byteData(), str.end().byteData(), str.begin().numChar() == 0 ) );
+		if( !Graph->required().empty() && !str.findFirst( Graph->required().substr() ) )
+		{
+			EON_RX_STATS( ++stats.Counts.Rejected; )
+			return rx::match();
+		}
 
-		for( auto pos = str.begin(); pos != str.end(); ++pos )
+		std::unique_ptr<rx::Dfa::Runner> dfa;
+		if( Graph->dfa() )
 		{
-			rx::RxData data( substring( pos, str.end() ), Graph.flags(), ++( (regex*)this )->Marker );
-			if( Graph.match( data ) )
+			dfa = std::make_unique<rx::Dfa::Runner>( *Graph->dfa() );
+			if( !dfa->search( str ) )
 			{
-				data.registerCapture( name_complete, substring( pos, data.pos() ) );
-				return rx::match( data.claimCaptures() );
+				EON_RX_STATS( ++stats.Counts.Rejected; )
+				return rx::match();
 			}
 		}
+
+		rx::MatchContext context( Graph->numNodes() );
+		EON_RX_STATS( context.counts( &stats.Counts ); )
+		for( auto pos = _candidate( str.begin(), str.end() ); pos != str.end(); pos = _candidate( pos + 1, str.end() ) )
+		{
+			EON_RX_STATS( stats.attempt( pos ); )
+			substring area( pos, str.end() );
+			if( dfa )
+			{
+				string::iterator end;
+				if( !dfa->matchEnd( area, _dfaOnly(), end ) )
+					continue;
+				if( _dfaOnly() )
+					return _result( substring( pos, end ) );
+			}
+			rx::RxData data( area, Graph->flags(), context );
+			if( Graph->match( data ) )
+				return _result( substring( pos, data.pos() ), &data );
+		}
+		EON_RX_STATS( stats.skipTo( str.end() ); )
 		return rx::match();
 	}
 	rx::match regex::findLast( const substring& str ) const
 	{
-		if( str.empty() || Graph.empty() )
+		if( str.empty() || !Graph )
 			return rx::match();
+		EON_RX_STATS( rx::CallStats stats( Counters.get(), str.begin() ); )
 
+		if( !Graph->required().empty() && !str.findFirst( Graph->required().substr() ) )
+		{
+			EON_RX_STATS( ++stats.Counts.Rejected; )
+			return rx::match();
+		}
+
+		std::unique_ptr<rx::Dfa::Runner> dfa;
+		if( Graph->dfa() )
+		{
+			dfa = std::make_unique<rx::Dfa::Runner>( *Graph->dfa() );
+			if( !dfa->search( str ) )
+			{
+				EON_RX_STATS( ++stats.Counts.Rejected; )
+				return rx::match();
+			}
+		}
+
+		auto first_bytes = str.begin().validUTF8() ? Graph->firstBytes() : nullptr;
+		rx::MatchContext context( Graph->numNodes() );
+		EON_RX_STATS( context.counts( &stats.Counts ); )
 		for( auto pos = str.last(); pos; --pos )
 		{
-			rx::RxData data( substring( pos, str.end() ), Graph.flags(), ++( (regex*)this )->Marker );
-			if( Graph.match( data ) )
+			if( first_bytes != nullptr && !( *first_bytes )[ static_cast<byte_t>( *pos.byteData() ) ] )
 			{
-				data.registerCapture( name_complete, substring( pos - 1, data.pos() ) );
-				return rx::match( data.claimCaptures() );
+				EON_RX_STATS( ++stats.Counts.Skipped; )
+				continue;
 			}
+			EON_RX_STATS( ++stats.Counts.Attempts; )
+			substring area( pos, str.end() );
+			if( dfa )
+			{
+				string::iterator end;
+				if( !dfa->matchEnd( area, _dfaOnly(), end ) )
+					continue;
+				if( _dfaOnly() )
+					return _result( substring( pos - 1, end ) );
+			}
+			rx::RxData data( area, Graph->flags(), context );
+			if( Graph->match( data ) )
+				return _result( substring( pos - 1, data.pos() ), &data );
 		}
 		return rx::match();
 	}
@@ -65,4 +152,49 @@ namespace eon
 		}
 		return matches;
 	}
+
+
+
+
+	string::iterator regex::_candidate( const string::iterator& pos, const string::iterator& end ) const
+	{
+		if( pos == end )
+			return end;
+		if( Graph->anchoredStart() )
+			return pos.numChar() == 0 ? pos : end;
+		if( !Graph->prefix().empty() )
+		{
+			auto found = substring( pos, end ).findFirst( Graph->prefix().substr() );
+			return found ? found.begin() : end;
+		}
+
+		auto first_bytes = Graph->firstBytes();
+		if( first_bytes == nullptr || !pos.validUTF8() )
+			return pos;
+		auto byte = first_bytes->findFirstIn( pos.byteData(), end.byteData() );
+		if( byte == end.byteData() )
+			return end;
+		index_t num_char = 0;
+		string_iterator::scanUtf8( pos.byteData(), byte, num_char );
+		return string::iterator( pos, byte, pos.numChar() + num_char );
+	}
+
+	rx::match regex::_result( const substring& complete, const rx::RxData* data ) const
+	{
+		std::vector<substring> captures( Graph->captureSlots()->size() );
+		captures[ 0 ] = complete;
+		if( data != nullptr )
+			data->captures( captures );
+		return rx::match( std::move( captures ), Graph->captureSlots() );
+	}
+
+	rx::match regex::_literalResult( const string::iterator& from, const rx::LiteralMatcher::Found& found ) const
+	{
+		if( !found )
+			return rx::match();
+		index_t num_char = 0;
+		string_iterator::scanUtf8( from.byteData(), found.Begin, num_char );
+		string::iterator begin( from, found.Begin, from.numChar() + num_char );
+		return _result( substring( begin, string::iterator( from, found.End, begin.numChar() + found.NumChars ) ) );
+	}
 }
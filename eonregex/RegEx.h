@@ -1,5 +1,6 @@
 #pragma once
 #include "Graph.h"
+#include "GraphCache.h"
 #include "Match.h"
 #include "RxData.h"
 #include <eonexcept/Exception.h>
@@ -11,15 +12,57 @@
 //
 namespace eon
 {
+	namespace rx
+	{
+		class regex_set;
+	}
+
+
 	///////////////////////////////////////////////////////////////////////////
 	//
 	// Eon Regular Expression Class - eon::regex
 	//
 	// Regular expressions on [eon::string]s.
 	//
+	// All matching and searching methods are 'const' for real, all state
+	// involved is local to the call, so a single regex object can be used
+	// from multiple threads at the same time.
+	//
+	// Expressions without backreferences, negations, word boundaries, and
+	// line/word anchoring are also compiled into a lazy DFA (see
+	// [eon::rx::Dfa]), which rejects non-matches in linear time before the
+	// (backtracking) matcher is run. Flag 'd' makes the DFA the only matcher
+	// (leftmost-longest, no captures besides the complete match), flag '!d'
+	// disables it.
+	//
+	// When searching, start positions are skipped using the literals that
+	// every match must start with or contain, or the set of bytes that a
+	// match can start with. Flag '!p' disables this.
+	//
+	// Expressions that are just fixed strings, or alternatives of them
+	// (optionally anchored), are matched and searched for by comparing bytes
+	// instead (see [eon::rx::LiteralMatcher]), [strStruct] tells if so.
+	// Flag '!l' disables this.
+	//
+	// Parsed expressions are cached (see [eon::rx::GraphCache]), so
+	// constructing a regex for the same pattern and flags again is cheap.
+	//
+	// When built with EON_REGEX_STATS, node visits, backtracks, prefilter
+	// skips, etc. are counted for each regex (see [stats]), to find out why
+	// an expression is slow.
+	//
+	// Input too big to hold in memory can be searched using
+	// [eon::regex::scanner] (include <eonregex/Scanner.h>). To find which of
+	// many expressions match, use [eon::rx::regex_set] (include
+	// <eonregex/RegexSet.h>).
+	//
 	class regex
 	{
 	public:
+		// Streaming search, see Scanner.h
+		class scanner;
+
+
 		///////////////////////////////////////////////////////////////////////
 		//
 		// Construction
@@ -39,16 +82,16 @@ namespace eon
 		//          The exception message will contain details about what's
 		//          wrong with the 'expression' string.
 		inline regex( string expression, string flags = string() ) {
-			Raw = expression; Flags = flags; Graph.parse( Raw.substr(), Flags.substr() ); }
+			Raw = expression; Flags = flags; _parse(); }
 		inline regex( substring expression, substring flags ) {
-			Raw = expression; Flags = flags; Graph.parse( Raw.substr(), Flags.substr() ); }
+			Raw = expression; Flags = flags; _parse(); }
 
 		// Construct for an std::string 'expression'
 		// WARNING: Will throw InvalidExpression if invalid formatting.
 		//          The exception message will contain details about what's
 		//          wrong with the 'expression' string.
 		inline regex( const std::string& expression, std::string flags = std::string() ) {
-			Raw = substring( expression ); Flags = substring( flags ); Graph.parse( Raw.substr(), Flags.substr() ); }
+			Raw = substring( expression ); Flags = substring( flags ); _parse(); }
 
 		// Construct for a 'const char*' (C-string)
 		// WARNING: Will throw InvalidExpression if invalid formatting.
@@ -56,7 +99,7 @@ namespace eon
 		//          wrong with the 'expression' string.
 		inline regex( const char* expression, const char* flags = nullptr ) {
 			if( expression ) Raw = substring( expression ); if( flags ) Flags = substring( flags );
-			Graph.parse( Raw.substr(), Flags.substr() ); }
+			_parse(); }
 
 		// Construct for a source
 
@@ -74,16 +117,16 @@ namespace eon
 
 		// Copy the 'other' expression
 		inline regex& operator=( const regex& other ) {
-			Graph = other.Graph; Raw = other.Raw; Flags = other.Flags; return *this; }
+			Graph = other.Graph; Raw = other.Raw; Flags = other.Flags; Counters = other.Counters; return *this; }
 
 		// Take ownership of the details of the 'other' expression
 		inline regex& operator=( regex&& other ) noexcept {
 			Graph = std::move( other.Graph ); Raw = std::move( other.Raw ); Flags = std::move( other.Flags );
-			return *this; }
+			Counters = std::move( other.Counters ); return *this; }
 
 
 		// Clear this expression
-		inline void clear() noexcept { Graph.clear(); Raw.clear(); Flags.clear(); }
+		inline void clear() noexcept { Graph.reset(); Raw.clear(); Flags.clear(); Counters.reset(); }
 
 
 
@@ -102,8 +145,22 @@ namespace eon
 		// Get the flags
 		inline const string& flags() const noexcept { return Flags; }
 
-		// Get the complete (optimized) pattern
-		inline string strStruct() const { return Graph.strStruct(); }
+		// Get the complete (optimized) pattern, prefixed by "[literal]" or
+		// "[literal set]" if matched by comparing bytes
+		inline string strStruct() const { return Graph ? Graph->strStruct() : string(); }
+
+
+		// Get statistics for all matching and searching done by this
+		// expression (and its copies) so far
+		// NOTE: Only counted when built with EON_REGEX_STATS (CMake option),
+		//       all zeros otherwise!
+		inline rx::Stats stats() const noexcept { return Counters ? Counters->get() : rx::Stats(); }
+
+		// Reset the statistics
+		inline void resetStats() noexcept { if( Counters ) Counters->reset(); }
+
+		// Get [strStruct] followed by [stats], for dumping
+		inline string strStats() const { return strStruct() + "\n" + stats().str(); }
 
 
 
@@ -159,8 +216,30 @@ namespace eon
 
 
 	private:
-		rx::Graph Graph;
+		friend class rx::regex_set;
+
+		inline bool _dfaOnly() const noexcept { return Graph->flags() & rx::Flag::dfa; }
+
+		// Get the graph from the cache (see [eon::rx::GraphCache]), none if
+		// the expression is empty
+		inline void _parse() {
+			if( !Raw.empty() ) { Graph = rx::GraphCache::get().graph( Raw, Flags ); if( Graph->empty() ) Graph.reset(); }
+			EON_RX_STATS( Counters = std::make_shared<rx::StatsCounter>(); ) }
+		// Get match result for the 'complete' match, with captures from
+		// 'data' (if any)
+		rx::match _result( const substring& complete, const rx::RxData* data = nullptr ) const;
+
+		// Get match result for a match 'found' by the literal matcher, in
+		// the string of 'from'
+		rx::match _literalResult( const string::iterator& from, const rx::LiteralMatcher::Found& found ) const;
+
+		// Get the first position from 'pos' where a match can start,
+		// according to the literal prefilter
+		string::iterator _candidate( const string::iterator& pos, const string::iterator& end ) const;
+
+	private:
+		std::shared_ptr<const rx::Graph> Graph;
 		string Raw, Flags;
-		int Marker{ 0 };
+		std::shared_ptr<rx::StatsCounter> Counters;	// Only if counting (EON_REGEX_STATS)
 	};
 }
\ No newline at end of file
@@ -0,0 +1,164 @@
+#pragma once
+#include "RegEx.h"
+#include <initializer_list>
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// The 'eon' namespace encloses all public functionality
+//
+namespace eon
+{
+	///////////////////////////////////////////////////////////////////////////
+	//
+	// The 'eon::rx' namespace enclosed special elements for Eon regular
+	// expressions
+	//
+	namespace rx
+	{
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Eon Regular Expression Set Class - eon::rx::regex_set
+		//
+		// A set of [eon::regex]es, for finding which of them match a string
+		// without searching it once for each.
+		//
+		// The expressions that can be matched by DFA (see [eon::rx::Dfa]) are
+		// combined into one engine, which finds all of them that can match
+		// in a single pass over the string. Only those are then searched
+		// for, to get the exact same results as [eon::regex::findFirst].
+		// Expressions that cannot be combined are searched for one at a
+		// time.
+		//
+		// NOTE: Like regex, a set can be used from multiple threads at the
+		//       same time (as long as it isn't modified)!
+		//
+		class regex_set
+		{
+			///////////////////////////////////////////////////////////////////
+			//
+			// Construction
+			//
+		public:
+
+			// Default constructor for empty set
+			regex_set() = default;
+
+			// Copy the 'other' set
+			inline regex_set( const regex_set& other ) { *this = other; }
+
+			// Take ownership of the 'other' set
+			regex_set( regex_set&& other ) noexcept = default;
+
+			// Construct for 'expressions', numbered in order from zero
+			inline regex_set( std::initializer_list<regex> expressions ) {
+				for( auto& expression : expressions ) add( expression ); }
+
+			virtual ~regex_set() = default;
+
+
+
+
+			///////////////////////////////////////////////////////////////////
+			//
+			// Modifier Methods
+			//
+		public:
+
+			// Copy the 'other' set
+			regex_set& operator=( const regex_set& other );
+
+			// Take ownership of the 'other' set
+			regex_set& operator=( regex_set&& other ) noexcept = default;
+
+
+			// Add an 'expression'
+			// Returns the number of the expression within the set.
+			index_t add( const regex& expression );
+
+			// Add an expression
+			// Returns the number of the expression within the set.
+			// WARNING: Throws [eon::rx::InvalidExpression] if invalid!
+			inline index_t add( const string& expression, const string& flags = string() ) {
+				return add( regex( expression, flags ) ); }
+
+			// Clear the set
+			void clear() noexcept;
+
+
+
+
+			///////////////////////////////////////////////////////////////////
+			//
+			// Read-only Methods
+			//
+		public:
+
+			// Get number of expressions
+			inline index_t size() const noexcept { return static_cast<index_t>( Expressions.size() ); }
+
+			// Check if the set is empty
+			inline bool empty() const noexcept { return Expressions.empty(); }
+
+			// Get expression by number
+			inline const regex& operator[]( index_t number ) const { return Expressions[ number ]; }
+
+			// Get number of expressions combined into one engine (the rest
+			// are searched for one at a time)
+			inline index_t numCombined() const noexcept { return Automaton ? Automaton->numPatterns() : 0; }
+
+
+
+
+			///////////////////////////////////////////////////////////////////
+			//
+			// Searching
+			//
+		public:
+
+			// Find which expressions match somewhere within 'str'
+			// Returns the numbers of the expressions, in order.
+			std::vector<index_t> matches( const substring& str ) const;
+			inline std::vector<index_t> matches( const string& str ) const { return matches( str.substr() ); }
+			inline std::vector<index_t> matches( const std::string& str ) const { return matches( substring( str ) ); }
+			inline std::vector<index_t> matches( const char* str ) const { return matches( substring( str ) ); }
+
+			// Find the first match within 'str' of each expression that
+			// matches, as by [eon::regex::findFirst]
+			// Returns pairs of expression number and match, in order of
+			// expression number.
+			std::vector<std::pair<index_t, match>> findFirst( const substring& str ) const;
+			inline std::vector<std::pair<index_t, match>> findFirst( const string& str ) const {
+				return findFirst( str.substr() ); }
+			inline std::vector<std::pair<index_t, match>> findFirst( const std::string& str ) const {
+				return findFirst( substring( str ) ); }
+			inline std::vector<std::pair<index_t, match>> findFirst( const char* str ) const {
+				return findFirst( substring( str ) ); }
+
+
+
+
+			///////////////////////////////////////////////////////////////////
+			//
+			// Helpers
+			//
+		private:
+
+			// Find the combined expressions that can match within 'str',
+			// flagging them in 'candidates' (which is sized for the set).
+			void _candidates( const substring& str, std::vector<bool>& candidates ) const;
+
+
+
+
+			///////////////////////////////////////////////////////////////////
+			//
+			// Attributes
+			//
+		private:
+			std::vector<regex> Expressions;
+			std::vector<bool> Combined;		// Per expression, if in 'Automaton'
+			std::unique_ptr<Dfa> Automaton;
+		};
+	}
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RxDefs.h"
+#include "Stats.h"
 #include <map>
 #include <eonstring/Name.h>
 
@@ -18,28 +19,62 @@ namespace eon
 	//
 	namespace rx
 	{
-		using captures_t = std::unordered_map<name_t, substring>;
+		// Capture group names of a graph, indexed by capture slot (resolved
+		// once, when the graph is finalized).
+		// Slot 0 is always the complete match.
+		class CaptureSlots
+		{
+		public:
+			inline CaptureSlots() { Names.push_back( name_complete ); }
+
+			// Get slot for 'name', adding it if new
+			inline index_t slot( name_t name ) { auto found = find( name ); if( found != no_index ) return found;
+				Names.push_back( name ); return Names.size() - 1; }
+
+			// Find slot for 'name', [eon::no_index] if not a capture name
+			inline index_t find( name_t name ) const noexcept {
+				for( index_t i = 0; i < Names.size(); ++i ) { if( Names[ i ] == name ) return i; } return no_index; }
+
+			inline name_t name( index_t slot ) const noexcept { return Names[ slot ]; }
+			inline index_t size() const noexcept { return Names.size(); }
+
+		private:
+			std::vector<name_t> Names;
+		};
+
+		static const uint32_t NoCapture{ UINT32_MAX };
+
+		// A registered capture.
+		// The captures of an [eon::rx::RxData] object are a chain from the
+		// latest record, back through the ones registered before it, stored
+		// in the [eon::rx::MatchContext]. Copying data objects (which is
+		// done a lot when backtracking) therefore never copies captures.
+		struct CaptureRecord
+		{
+			substring Value;
+			index_t Slot{ 0 };
+			uint32_t Prev{ NoCapture };
+		};
+
+		class MatchContext;
 
 		class RxData
 		{
 		public:
 			RxData() = default;
-			inline RxData( const RxData& other ) {
-				if( other.Captures ) { Captures = new captures_t( *other.Captures ); }
-				Src = other.Src; CmpFlags = other.CmpFlags; Pos = other.Pos; Marker = other.Marker; }
+			inline RxData( const RxData& other ) { *this = other; }
 			inline RxData( RxData&& other ) noexcept { *this = std::move( other ); }
-			inline RxData( const substring& source, Flag flags, uint16_t marker ) noexcept {
-				Src = source; Pos = Src.begin(); CmpFlags = flags; Marker = marker; }
-			virtual ~RxData() { reset(); }
+			RxData( const substring& source, Flag flags, MatchContext& context ) noexcept;
+			virtual ~RxData() = default;
 
-			inline void reset() noexcept { if( Captures ) { delete Captures; Captures = nullptr; } }
+			inline void reset() noexcept { LastCapture = NoCapture; }
 
 			inline RxData& operator=( const RxData& other ) {
-				reset(); if( other.Captures ) { Captures = new captures_t( *other.Captures ); }
-				Src = other.Src; CmpFlags = other.CmpFlags; Pos = other.Pos; Marker = other.Marker; return *this; }
-			inline RxData& operator=( RxData&& other ) noexcept { reset(); if( other.Captures ) {
-				Captures = other.Captures; other.Captures = nullptr; } Src = other.Src; CmpFlags = other.CmpFlags;
-				other.CmpFlags = Flag::none; Pos = other.Pos; Marker = other.Marker; return *this; }
+				Src = other.Src; CmpFlags = other.CmpFlags; Pos = other.Pos; LastCapture = other.LastCapture;
+				Marker = other.Marker; Ctx = other.Ctx; return *this; }
+			inline RxData& operator=( RxData&& other ) noexcept { Src = other.Src; CmpFlags = other.CmpFlags;
+				other.CmpFlags = Flag::none; Pos = other.Pos; LastCapture = other.LastCapture;
+				other.LastCapture = NoCapture; Marker = other.Marker; Ctx = other.Ctx; return *this; }
 
 			inline const substring& source() const noexcept { return Src; }
 			inline const string::iterator& pos() const noexcept { return Pos; }
@@ -68,14 +103,19 @@ namespace eon
 
 			inline uint16_t marker() const noexcept { return Marker; }
 
+			// Get the context of the match call this data belongs to
+			inline MatchContext& context() const noexcept { return *Ctx; }
 
-			// Captures
-			inline void registerCapture( name_t name, const substring& match ) {
-				if( !Captures ) Captures = new captures_t(); (*Captures)[ name ] = match; }
-			substring findCapture( name_t name ) const noexcept;
-			inline captures_t* captures() noexcept { return Captures; }
-			inline captures_t* claimCaptures() noexcept { auto capt = Captures; Captures = nullptr; return capt; }
-			inline void addCaptures( captures_t* other ) { if( other ) for( auto& capture : *other ) registerCapture( capture.first, capture.second ); }
+
+			// Captures, by slot (see [eon::rx::CaptureSlots])
+			inline void registerCapture( index_t slot, const substring& match );
+			substring findCapture( index_t slot ) const noexcept;
+
+			// Add the captures of 'other' (taking precedence over existing)
+			void addCaptures( const RxData& other );
+
+			// Get the latest capture for each slot
+			void captures( std::vector<substring>& slots ) const;
 
 
 
@@ -84,8 +124,59 @@ namespace eon
 			substring Src;
 			string_iterator Pos;
 			Flag CmpFlags{ Flag::none };
-			captures_t* Captures{ nullptr };
+			uint32_t LastCapture{ NoCapture };
+			uint16_t Marker{ 0 };
+			MatchContext* Ctx{ nullptr };
+		};
+
+
+		// Match state of a single node, for a single match call
+		struct NodeState
+		{
+			RxData Matched;
+			RecordedPos PrevPos;
+			string::iterator Start;
+			bool Captured{ false };
+		};
+
+
+		// All state involved in matching a compiled graph (see [eon::rx::Graph])
+		// against an input, one element for each node, indexed by node ID.
+		// The graph itself is never modified when matching, so the same graph
+		// can be matched from many threads at the same time, as long as each
+		// match call has its own context.
+		class MatchContext
+		{
+		public:
+			MatchContext() = delete;
+			inline explicit MatchContext( index_t num_nodes ) : States( num_nodes ) {}
+
+			inline NodeState& state( index_t node_id ) noexcept { return States[ node_id ]; }
+
+			// Get a new marker for recording positions
+			inline uint16_t newMarker() noexcept { return ++Marker; }
+
+			// Add a capture record, after 'prev', returning its index
+			inline uint32_t addCapture( uint32_t prev, index_t slot, const substring& value ) {
+				Captures.push_back( CaptureRecord{ value, slot, prev } );
+				return static_cast<uint32_t>( Captures.size() - 1 ); }
+			inline const CaptureRecord& capture( uint32_t index ) const noexcept { return Captures[ index ]; }
+
+			// Statistics for the call (see [eon::rx::Stats]), nullptr if not
+			// counting
+			inline Stats* counts() const noexcept { return Counts; }
+			inline void counts( Stats* counts ) noexcept { Counts = counts; }
+
+		private:
+			std::vector<NodeState> States;
+			std::vector<CaptureRecord> Captures;
 			uint16_t Marker{ 0 };
+			Stats* Counts{ nullptr };
 		};
+
+
+		inline void RxData::registerCapture( index_t slot, const substring& match ) {
+			EON_RX_STATS( if( Ctx->counts() ) ++Ctx->counts()->Captures; )
+			LastCapture = Ctx->addCapture( LastCapture, slot, match ); }
 	}
 }
@@ -66,6 +66,11 @@ namespace eon
 			no_exposing = 0x0040,			// Do not expose literal characters
 			
 			failfast_fixed_end = 0x0080,	// When <fixed>$ at the end and not 'lines', check end of input first
+
+			dfa = 0x0100,			// Match using the DFA engine only (leftmost-longest, no captures)
+			no_dfa = 0x0200,		// Do not use the DFA engine to reject non-matches early
+			no_prefilter = 0x0400,	// Do not skip ahead to literals when searching
+			no_literal = 0x0800,	// Do not use the specialized matcher for literal expressions
 		};
 		inline bool operator&( Flag a, Flag b ) noexcept { return static_cast<int>( a ) & static_cast<int>( b ); }
 		inline Flag& operator|=( Flag& a, Flag b ) noexcept {
@@ -0,0 +1,155 @@
+#pragma once
+#include "RegEx.h"
+#include <eonsource/Raw.h>
+#include <functional>
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// The 'eon' namespace encloses all public functionality
+//
+namespace eon
+{
+	///////////////////////////////////////////////////////////////////////////
+	//
+	// Eon Regular Expression Scanner Class - eon::regex::scanner
+	//
+	// Search input that is too big to hold in memory, chunk by chunk, for all
+	// matches of an [eon::regex]. The input can come from an
+	// [eon::source::Raw], a read function, or be fed in chunks.
+	//
+	// Matches are found as by [eon::regex::findAll], and reported with their
+	// byte offset from the start of the input. Chunks can be of any size and
+	// split anywhere (even inside UTF-8 characters), only a window of at
+	// most two times the maximum match size (plus the chunk being fed) is
+	// kept in memory.
+	//
+	// NOTE: Matches are assumed to be shorter than the maximum match size
+	//       (64 KiB by default). Longer matches are cut short, and end of
+	//       input anchors can match at the end of the window.
+	//
+	class regex::scanner
+	{
+	public:
+		// Function called for each match, with the byte offset of the match
+		// from the start of the input.
+		// NOTE: The match (and its captures) is only valid during the call!
+		// Return false to stop scanning.
+		using callback = std::function<bool( size_t offset, const rx::match& found )>;
+
+		// Function reading up to 'size' bytes into 'buffer'.
+		// Returns number of bytes read, zero at end of input.
+		using reader = std::function<size_t( char* buffer, size_t size )>;
+
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Construction
+		//
+	public:
+
+		scanner() = delete;
+		scanner( const scanner& ) = delete;
+		scanner( scanner&& ) = delete;
+
+		// Construct for an 'expression' (which must outlive the scanner),
+		// calling 'found' for each match.
+		scanner( const regex& expression, callback found, size_t max_match = 64 * 1024 );
+
+		virtual ~scanner() = default;
+
+		scanner& operator=( const scanner& ) = delete;
+		scanner& operator=( scanner&& ) = delete;
+
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Scanning
+		//
+	public:
+
+		// Feed the next chunk of input
+		// Matches are reported as soon as they are certain.
+		// WARNING: Throws [eon::InvalidUTF8] if the input is not valid UTF-8!
+		void feed( const char* bytes, size_t size );
+		inline void feed( const std::string& bytes ) { feed( bytes.c_str(), bytes.size() ); }
+
+		// Mark end of input, reporting the remaining matches
+		// WARNING: Throws [eon::InvalidUTF8] if the input is not valid UTF-8!
+		void finish();
+
+
+		// Scan all of a 'source', 'chunk_size' bytes at a time, then finish.
+		void scan( source::Raw& source, size_t chunk_size = 64 * 1024 );
+
+		// Scan all input from 'read', 'chunk_size' bytes at a time, then
+		// finish.
+		void scan( const reader& read, size_t chunk_size = 64 * 1024 );
+
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Read-only Methods
+		//
+	public:
+
+		// Check if stopped by the callback
+		inline bool stopped() const noexcept { return Stopped; }
+
+		// Check if finished (end of input)
+		inline bool finished() const noexcept { return Finished; }
+
+		// Get number of bytes fed so far
+		inline size_t numBytes() const noexcept { return NumBytes; }
+
+		// Get number of matches reported so far
+		inline size_t numMatches() const noexcept { return NumMatches; }
+
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Helpers
+		//
+	private:
+
+		// Search the pending input, all of it if 'final'
+		void _scan( bool final );
+
+		// Get number of pending bytes that are complete UTF-8 characters
+		size_t _complete() const noexcept;
+
+		// Get start of the character at byte 'pos' of the pending input
+		size_t _charStart( size_t pos ) const noexcept;
+
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Attributes
+		//
+	private:
+		const regex& Expr;
+		callback Found;
+		size_t MaxMatch{ 0 };
+
+		// Input not yet searched, preceded by the last character that has
+		// been (so it's there for anchors and word boundaries)
+		std::string Pending;
+		size_t Behind{ 0 };			// Bytes in 'Pending' already searched
+		size_t Offset{ 0 };			// Input offset of the start of 'Pending'
+
+		size_t NumBytes{ 0 };
+		size_t NumMatches{ 0 };
+		bool Stopped{ false };
+		bool Finished{ false };
+	};
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <eonstring/String.h>
+#include <atomic>
+
+
+// Counting is compiled in only when EON_REGEX_STATS is defined (CMake
+// option EON_REGEX_STATS), 'EON_RX_STATS( statement )' is otherwise empty.
+#ifdef EON_REGEX_STATS
+#	define EON_RX_STATS( statement ) statement
+#else
+#	define EON_RX_STATS( statement )
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// The 'eon' namespace encloses all public functionality
+//
+namespace eon
+{
+	///////////////////////////////////////////////////////////////////////////
+	//
+	// The 'eon::rx' namespace enclosed special elements for Eon regular
+	// expressions
+	//
+	namespace rx
+	{
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Statistics for matching and searching, see [eon::regex::stats]
+		//
+		struct Stats
+		{
+			// Check if counting is compiled in
+#ifdef EON_REGEX_STATS
+			static constexpr bool Enabled{ true };
+#else
+			static constexpr bool Enabled{ false };
+#endif
+
+			size_t Calls{ 0 };			// Number of match/findFirst/findLast calls
+			size_t Rejected{ 0 };		// Calls rejected by literals, anchoring or the DFA
+			size_t Skipped{ 0 };		// Start positions skipped by the prefilter
+			size_t Attempts{ 0 };		// Start positions where matching was attempted
+			size_t NodeVisits{ 0 };		// Number of times a node was matched
+			size_t Backtracks{ 0 };		// Number of times a node had to try another way
+			size_t Captures{ 0 };		// Number of captures registered
+
+			Stats& operator+=( const Stats& other ) noexcept;
+
+			// Get as "name=value" pairs, one per line
+			string str() const;
+		};
+
+
+		// Thread-safe totals of [eon::rx::Stats]
+		class StatsCounter
+		{
+		public:
+			StatsCounter() = default;
+			StatsCounter( const StatsCounter& ) = delete;
+			StatsCounter& operator=( const StatsCounter& ) = delete;
+
+			void add( const Stats& stats ) noexcept;
+			Stats get() const noexcept;
+			void reset() noexcept;
+
+		private:
+			std::atomic<size_t> Calls{ 0 }, Rejected{ 0 }, Skipped{ 0 }, Attempts{ 0 }, NodeVisits{ 0 },
+				Backtracks{ 0 }, Captures{ 0 };
+		};
+
+
+		// Counts for one call, added to the totals (if any) when done
+		class CallStats
+		{
+		public:
+			inline CallStats( StatsCounter* totals, const string::iterator& start ) noexcept {
+				Totals = totals; NextPos = start.numChar(); ++Counts.Calls; }
+			CallStats( const CallStats& ) = delete;
+			inline ~CallStats() { if( Totals ) Totals->add( Counts ); }
+
+			CallStats& operator=( const CallStats& ) = delete;
+
+			// Count an attempt at 'pos', and the positions skipped since
+			// the previous attempt
+			inline void attempt( const string::iterator& pos ) noexcept {
+				Counts.Skipped += pos.numChar() - NextPos; NextPos = pos.numChar() + 1; ++Counts.Attempts; }
+
+			// Count the positions skipped up to 'end'
+			inline void skipTo( const string::iterator& end ) noexcept {
+				if( end.numChar() > NextPos ) Counts.Skipped += end.numChar() - NextPos; NextPos = end.numChar(); }
+
+			Stats Counts;
+
+		private:
+			StatsCounter* Totals{ nullptr };
+			index_t NextPos{ 0 };
+		};
+	}
+}
@@ -5,9 +5,9 @@ namespace eon
 {
 	namespace rx
 	{
-		bool Backreference::_match( RxData& data, index_t steps )
+		bool Backreference::_match( RxData& data, index_t steps ) const
 		{
-			auto group = data.findCapture( Name );
+			auto group = data.findCapture( Slot );
 			if( group )
 			{
 				if( !data )
@@ -31,19 +31,23 @@ namespace eon
 			inline Node* copy() const override { return new Backreference( *this ); }
 
 			inline Backreference& operator=( const Backreference& other ) {
-				*static_cast<Node*>( this ) = other; Name = other.Name; return *this; }
+				*static_cast<Node*>( this ) = other; Name = other.Name; Slot = other.Slot; return *this; }
 			inline Backreference& operator=( Backreference&& other ) noexcept {
-				*static_cast<Node*>( this ) = std::move( other ); Name = std::move( other.Name ); return *this; }
+				*static_cast<Node*>( this ) = std::move( other ); Name = std::move( other.Name ); Slot = other.Slot;
+				return *this; }
 
 		private:
-			bool _match( RxData& data, index_t steps ) override;
+			bool _match( RxData& data, index_t steps ) const override;
 			inline string _strStruct() const override { return "@:<" + str( Name ) + ">"; }
 			inline bool _equal( const Node& other, cmpflag flags ) const noexcept override {
 				return Name == dynamic_cast<const Backreference*>( &other )->Name; }
 			inline index_t _countMinCharsRemaining() noexcept override { return MinCharsRemaining = 0; }
+			inline void _finalize( index_t& num_nodes, CaptureSlots& captures ) override {
+				Slot = captures.slot( Name ); Node::_finalize( num_nodes, captures ); }
 
 		private:
 			name_t Name{ no_name };
+			index_t Slot{ 0 };
 		};
 	}
 }
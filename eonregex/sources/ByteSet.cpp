@@ -0,0 +1,100 @@
+#include "../ByteSet.h"
+#if defined( __x86_64__ ) || defined( _M_X64 )
+#	define EON_BYTESET_SIMD
+#	include <immintrin.h>
+#	ifdef _MSC_VER
+#		include <intrin.h>
+#		define EON_SSSE3
+#	else
+#		define EON_SSSE3 __attribute__(( target( "ssse3" ) ))
+#	endif
+#endif
+
+
+namespace eon
+{
+	namespace rx
+	{
+#ifdef EON_BYTESET_SIMD
+		static inline int _firstBit( unsigned int mask ) noexcept
+		{
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward( &index, mask );
+			return static_cast<int>( index );
+#else
+			return __builtin_ctz( mask );
+#endif
+		}
+
+		// Classify 16 bytes at a time: The low nibble of each byte selects a
+		// row, the high nibble selects a bit in that row. High nibbles from
+		// 8 and up (non-ASCII) select no bit at all.
+		EON_SSSE3 static const char* _findFirstSsse3(
+			const byte_t* rows, bool non_ascii, const char* c, const char* end, bool in ) noexcept
+		{
+			auto table = _mm_loadu_si128( reinterpret_cast<const __m128i*>( rows ) );
+			auto bits = _mm_setr_epi8( 1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0 );
+			auto low_nibble = _mm_set1_epi8( 0x0F );
+			for( ; end - c >= 16; c += 16 )
+			{
+				auto input = _mm_loadu_si128( reinterpret_cast<const __m128i*>( c ) );
+				auto row = _mm_shuffle_epi8( table, _mm_and_si128( input, low_nibble ) );
+				auto bit = _mm_shuffle_epi8( bits, _mm_and_si128( _mm_srli_epi16( input, 4 ), low_nibble ) );
+				auto outside = static_cast<unsigned int>( _mm_movemask_epi8(
+					_mm_cmpeq_epi8( _mm_and_si128( row, bit ), _mm_setzero_si128() ) ) );
+				unsigned int stop = outside;
+				if( in )
+				{
+					stop = ~outside & 0xFFFF;
+					if( non_ascii )
+						stop |= static_cast<unsigned int>( _mm_movemask_epi8( input ) );
+				}
+				if( stop != 0 )
+					return c + _firstBit( stop );
+			}
+			return c;
+		}
+
+		static bool _haveSsse3() noexcept
+		{
+#ifdef _MSC_VER
+			int info[ 4 ];
+			__cpuid( info, 1 );
+			return ( info[ 2 ] & ( 1 << 9 ) ) != 0;
+#else
+			return __builtin_cpu_supports( "ssse3" );
+#endif
+		}
+#endif
+
+
+
+
+		const char* ByteSet::findFirstIn( const char* begin, const char* end ) const noexcept
+		{
+			return _findFirst( begin, end, true );
+		}
+		const char* ByteSet::findFirstNotIn( const char* begin, const char* end ) const noexcept
+		{
+			return _findFirst( begin, end, false );
+		}
+
+		const char* ByteSet::_findFirst( const char* begin, const char* end, bool in ) const noexcept
+		{
+			auto c = begin;
+#ifdef EON_BYTESET_SIMD
+			static const bool ssse3 = _haveSsse3();
+			if( ssse3 )
+				c = _findFirstSsse3( Rows, NonAscii, c, end, in );
+#endif
+			for( ; c != end; ++c )
+			{
+				auto byte = static_cast<byte_t>( *c );
+				if( in ? ( *this )[ byte ] : byte >= 128 || !ascii( byte ) )
+					break;
+			}
+			return c;
+		}
+	}
+}
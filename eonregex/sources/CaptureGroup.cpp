@@ -5,14 +5,15 @@ namespace eon
 {
 	namespace rx
 	{
-		bool CaptureGroup::_match( RxData& data, index_t steps )
+		bool CaptureGroup::_match( RxData& data, index_t steps ) const
 		{
-			Start = data.pos();
-			Captured = false;
+			auto& state = _state( data );
+			state.Start = data.pos();
+			state.Captured = false;
 			if( NodeGroup::_match( data, steps ) )
 			{
-				if( !Captured )
-					data.registerCapture( Name, substring( Start, data.pos() ) );
+				if( !state.Captured )
+					data.registerCapture( Slot, substring( state.Start, data.pos() ) );
 				return true;
 			}
 			return false;
@@ -33,12 +33,13 @@ namespace eon
 			inline Node* copy() const override { return new CaptureGroup( *this ); }
 
 			inline CaptureGroup& operator=( const CaptureGroup& other ) {
-				*static_cast<NodeGroup*>( this ) = other; Name = other.Name; return *this; }
+				*static_cast<NodeGroup*>( this ) = other; Name = other.Name; Slot = other.Slot; return *this; }
 			inline CaptureGroup& operator=( CaptureGroup&& other ) noexcept {
-				*static_cast<NodeGroup*>( this ) = std::move( other ); Name = std::move( other.Name ); return *this; }
+				*static_cast<NodeGroup*>( this ) = std::move( other ); Name = std::move( other.Name ); Slot = other.Slot;
+				return *this; }
 
 		private:
-			bool _match( RxData& data, index_t steps ) override;
+			bool _match( RxData& data, index_t steps ) const override;
 
 			inline string _strStruct() const override { return "@<" + str( Name ) + ">" + NodeGroup::_strStruct(); }
 
@@ -47,13 +48,15 @@ namespace eon
 
 			inline Node* _removeSuperfluousGroups() noexcept override {
 				if( Next ) Next = Next->_removeSuperfluousGroups(); return this; }
-			inline void _capture( RxData& data ) override {
-				data.registerCapture( Name, substring( Start, data.pos() ) ); Captured = true; }
+			inline void _capture( RxData& data ) const override {
+				auto& state = _state( data ); data.registerCapture( Slot, substring( state.Start, data.pos() ) );
+				state.Captured = true; }
+			inline void _finalize( index_t& num_nodes, CaptureSlots& captures ) override {
+				Slot = captures.slot( Name ); NodeGroup::_finalize( num_nodes, captures ); }
 
 		private:
 			name_t Name{ no_name };
-			string::iterator Start;
-			bool Captured{ false };
+			index_t Slot{ 0 };
 		};
 	}
 }
@@ -34,7 +34,7 @@ namespace eon
 				*static_cast<Node*>( this ) = std::move( other ); return *this; }
 
 		private:
-			inline bool _match( RxData& data, index_t step ) override {
+			inline bool _match( RxData& data, index_t step ) const override {
 				return string::isLetterLowerCase( data() ) ? data.advance() : false; }
 			inline string _strStruct() const override { return "\\u"; }
 			inline index_t _countMinCharsRemaining() noexcept override {
@@ -58,7 +58,7 @@ namespace eon
 				*static_cast<Node*>( this ) = std::move( other ); return *this; }
 
 		private:
-			inline bool _match( RxData& data, index_t step ) override {
+			inline bool _match( RxData& data, index_t step ) const override {
 				return string::isLetterUpperCase( data() ) ? data.advance() : false; }
 			inline string _strStruct() const override { return "\\U"; }
 			inline index_t _countMinCharsRemaining() noexcept override {
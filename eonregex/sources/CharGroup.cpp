@@ -1,4 +1,5 @@
 #include "../CharGroup.h"
+#include <algorithm>
 
 
 namespace eon
@@ -20,51 +21,135 @@ namespace eon
 		}
 
 
-		bool CharGroup::_match( RxData& data, index_t steps )
+		// Get the other case of a character, the character itself if none
+		static char_t _otherCase( char_t chr )
+		{
+			auto& loc = locale::get();
+			auto l = static_cast<char_t>( loc.toLower( static_cast<wchar_t>( chr ) ) );
+			auto u = static_cast<char_t>( loc.toUpper( static_cast<wchar_t>( chr ) ) );
+			if( l == u )
+				return chr;
+			return chr == l ? u : l;
+		}
+
+
+		bool CharGroup::_match( RxData& data, index_t steps ) const
 		{
 			if( data )
 			{
-				if( _match( data() ) )
-					return Value.Negate ? false : data.advance();
-				if( data.flags() & Flag::icase )
-				{
-					auto& chars = Characters::get();
-#ifdef EON_APPLE
-					auto l = std::tolower<wchar_t>( static_cast<wchar_t>( data() ), chars.locale() );
-					auto u = std::toupper<wchar_t>( static_cast<wchar_t>( data() ), chars.locale() );
-#else
-					auto l = std::tolower<char_t>( data(), chars.locale() );
-					auto u = std::toupper<char_t>( data(), chars.locale() );
-#endif
-					if( l != u )
-					{
-						if( data() == l )
-						{
-							if( _match( u ) )
-								return Value.Negate ? false : data.advance();
-						}
-						else
-						{
-							if( _match( l ) )
-								return Value.Negate ? false : data.advance();
-						}
-					}
-				}
+				auto chr = data();
+				if( chr < 128 ? Ascii.ascii( chr ) : _matchNonAscii( chr ) )
+					return data.advance();
+				return false;
 			}
 			if( Value.Negate )
 				data.advance();
 			return Value.Negate;
 		}
-		bool CharGroup::_match( char_t chr )
+		bool CharGroup::_matchNonAscii( char_t chr ) const
+		{
+			bool found = _inTable( chr ) || ( !Value.Special.empty() && _matchSpecial( chr ) );
+			if( !found && FoldMisses )
+			{
+				auto other = _otherCase( chr );
+				found = other != chr && _matchRaw( other );
+			}
+			return found != Value.Negate;
+		}
+		bool CharGroup::_inTable( char_t chr ) const noexcept
+		{
+			auto range = std::upper_bound( Table.begin(), Table.end(), chr,
+				[]( char_t c, const std::pair<char_t, char_t>& elm ) { return c < elm.first; } );
+			return range != Table.begin() && chr <= ( range - 1 )->second;
+		}
+
+		bool CharGroup::_matchRaw( char_t chr ) const
 		{
-			auto found = Value.Chars.find( chr );
-			if( found != Value.Chars.end() )
+			if( Value.Chars.find( chr ) != Value.Chars.end() )
 				return true;
 			for( auto& range : Value.Ranges )
 			{
 				if( chr >= range.first && chr <= range.second )
 					return true;
 			}
+			return _matchSpecial( chr );
+		}
+
+		void CharGroup::_compile( bool icase )
+		{
+			ICase = icase;
+			FoldMisses = false;
+
+			// All ASCII characters are decided up front
+			Ascii.clear();
+			for( char_t c = 0; c < 128; ++c )
+			{
+				bool found = _matchRaw( c );
+				if( icase )
+				{
+					// Some non-ASCII characters (like the Kelvin sign) have an
+					// ASCII letter as their other case
+					auto other = _otherCase( c );
+					if( other != c )
+					{
+						if( found )
+							FoldMisses = true;
+						else
+							found = _matchRaw( other );
+					}
+				}
+				if( found != Value.Negate )
+					Ascii.set( static_cast<byte_t>( c ) );
+			}
+
+			// Non-ASCII characters and ranges go into the table, with the
+			// other case of each character added when ignoring case. (Huge
+			// ranges and special character classes are case folded when
+			// matching instead.)
+			static const char_t max_fold{ 4096 };
+			std::vector<std::pair<char_t, char_t>> ranges;
+			auto add = [&ranges]( char_t first, char_t last ) {
+				if( last >= 128 && first <= last )
+					ranges.push_back( std::make_pair( std::max<char_t>( first, 128 ), last ) ); };
+			for( auto c : Value.Chars )
+			{
+				add( c, c );
+				if( icase )
+					add( _otherCase( c ), _otherCase( c ) );
+			}
+			for( auto& range : Value.Ranges )
+			{
+				add( range.first, range.second );
+				if( icase && range.first <= range.second )
+				{
+					if( range.second - range.first < max_fold )
+					{
+						for( auto c = range.first; c <= range.second; ++c )
+							add( _otherCase( c ), _otherCase( c ) );
+					}
+					else
+						FoldMisses = true;
+				}
+			}
+			if( icase && !Value.Special.empty() )
+				FoldMisses = true;
+
+			std::sort( ranges.begin(), ranges.end() );
+			Table.clear();
+			for( auto& range : ranges )
+			{
+				if( !Table.empty() && range.first <= Table.back().second + 1 )
+					Table.back().second = std::max( Table.back().second, range.second );
+				else
+					Table.push_back( range );
+			}
+
+			if( Value.Negate || !Table.empty() || !Value.Special.empty() || FoldMisses )
+				Ascii.set( 0x80 );
+		}
+
+		bool CharGroup::_matchSpecial( char_t chr ) const
+		{
 			for( auto& special : Value.Special )
 			{
 				switch( special )
@@ -0,0 +1,547 @@
+#include "../Dfa.h"
+#include "../NodeGroup.h"
+#include "../OpOr.h"
+#include "FixedValue.h"
+#include <cctype>
+
+
+namespace eon
+{
+	namespace rx
+	{
+		bool Dfa::compile( const Node& head, Flag flags )
+		{
+			Nfa.clear();
+			NumPatterns = 0;
+			return add( head, flags, 0 );
+		}
+
+		bool Dfa::add( const Node& head, Flag flags, uint32_t pattern )
+		{
+			// Existing caches are sized for the old NFA
+			Pool.clear();
+			auto size = Nfa.size();
+			Flags = flags;
+			auto accept = _add( NfaState::kind::accept );
+			Nfa[ accept ].Pattern = pattern;
+			uint32_t entry{ 0 };
+			if( !_compileChain( &head, accept, entry ) )
+			{
+				Nfa.resize( size );
+				return false;
+			}
+			Entry = size == 0 ? entry : _add( NfaState::kind::split, entry, Entry );
+			++NumPatterns;
+			return true;
+		}
+
+
+
+
+		bool Dfa::firstBytes( std::array<bool, 256>& bytes ) const
+		{
+			bytes.fill( false );
+			Cache cache;
+			cache.Visited.assign( Nfa.size(), 0 );
+			nfaset states;
+			for( bool at_start : { false, true } )
+			{
+				_nextGeneration( cache );
+				_closure( cache, Entry, at_start, states );
+			}
+
+			bool non_ascii = false;
+			for( auto id : states )
+			{
+				auto& state = Nfa[ id ];
+				switch( state.Kind )
+				{
+					case NfaState::kind::accept:
+						return false;
+					case NfaState::kind::chr:
+						if( state.Chr < 128 && !( state.Flags & Flag::icase ) )
+							bytes[ state.Chr ] = true;
+						else
+						{
+							for( char_t c = 0; c < 128; ++c )
+								bytes[ c ] = bytes[ c ] || _accepts( state, c );
+							non_ascii = non_ascii || state.Chr >= 128;
+						}
+						break;
+					case NfaState::kind::pred:
+						for( char_t c = 0; c < 128; ++c )
+							bytes[ c ] = bytes[ c ] || state.Ascii[ c ];
+						non_ascii = true;
+						break;
+					default:
+						// Only passes at the end, where no match starts
+						break;
+				}
+			}
+			if( non_ascii )
+			{
+				for( int byte = 0xC0; byte < 256; ++byte )
+					bytes[ byte ] = true;
+			}
+			return true;
+		}
+
+
+
+
+		Dfa::Runner::Runner( const Dfa& dfa ) : Engine( dfa )
+		{
+			{
+				std::lock_guard<std::mutex> lock( Engine.PoolLock );
+				if( !Engine.Pool.empty() )
+				{
+					Item = std::move( Engine.Pool.back() );
+					Engine.Pool.pop_back();
+					return;
+				}
+			}
+			Item = std::make_unique<Cache>();
+			Item->Visited.assign( Engine.Nfa.size(), 0 );
+			Item->clear();
+		}
+		Dfa::Runner::~Runner()
+		{
+			std::lock_guard<std::mutex> lock( Engine.PoolLock );
+			Engine.Pool.push_back( std::move( Item ) );
+		}
+
+		bool Dfa::Runner::matchEnd( const substring& str, bool longest, string_iterator& end )
+		{
+			auto& cache = *Item;
+			bool found = false;
+			auto state = Engine._start( cache, false, str.begin().numChar() == 0 );
+			if( cache.States[ state ]->Accepting )
+			{
+				end = str.begin();
+				if( !longest )
+					return true;
+				found = true;
+			}
+			for( auto pos = str.begin(); pos != str.end(); ++pos )
+			{
+				state = Engine._step( cache, state, *pos );
+				if( state == Dead )
+					return found;
+				if( cache.States[ state ]->Accepting )
+				{
+					end = pos + 1;
+					if( !longest )
+						return true;
+					found = true;
+				}
+			}
+			if( Engine._acceptAtEnd( cache, state ) )
+			{
+				end = str.end();
+				found = true;
+			}
+			return found;
+		}
+
+		bool Dfa::Runner::search( const substring& str )
+		{
+			auto& cache = *Item;
+			auto state = Engine._start( cache, true, str.begin().numChar() == 0 );
+			if( cache.States[ state ]->Accepting )
+				return true;
+			for( auto c : str )
+			{
+				state = Engine._step( cache, state, c );
+				if( cache.States[ state ]->Accepting )
+					return true;
+			}
+			return Engine._acceptAtEnd( cache, state );
+		}
+
+		index_t Dfa::Runner::searchAll( const substring& str, std::vector<bool>& found )
+		{
+			auto& cache = *Item;
+			index_t num_found = 0;
+			auto mark = [&]( const std::vector<uint32_t>& patterns ) {
+				for( auto pattern : patterns )
+				{
+					if( !found[ pattern ] )
+					{
+						found[ pattern ] = true;
+						++num_found;
+					}
+				}
+				return num_found == Engine.NumPatterns;
+			};
+
+			auto state = Engine._start( cache, true, str.begin().numChar() == 0 );
+			if( cache.States[ state ]->Accepting && mark( cache.States[ state ]->Patterns ) )
+				return num_found;
+			for( auto c : str )
+			{
+				state = Engine._step( cache, state, c );
+				if( cache.States[ state ]->Accepting && mark( cache.States[ state ]->Patterns ) )
+					return num_found;
+			}
+			if( Engine._acceptAtEnd( cache, state ) )
+				mark( cache.States[ state ]->PatternsAtEnd );
+			return num_found;
+		}
+
+
+
+
+		void Dfa::Cache::clear()
+		{
+			States.clear();
+			Ids.clear();
+			for( auto& start : Start )
+				start[ 0 ] = start[ 1 ] = Unknown;
+
+			// The dead state is the empty set
+			States.push_back( std::make_unique<DfaState>() );
+			Ids[ nfaset() ] = Dead;
+		}
+
+
+
+
+		uint32_t Dfa::_add( NfaState::kind kind, uint32_t out1, uint32_t out2 )
+		{
+			NfaState state;
+			state.Kind = kind;
+			state.Out1 = out1;
+			state.Out2 = out2;
+			state.Flags = Flags;
+			Nfa.push_back( std::move( state ) );
+			return static_cast<uint32_t>( Nfa.size() - 1 );
+		}
+
+		bool Dfa::_compileChain( const Node* node, uint32_t next, uint32_t& entry )
+		{
+			// The NFA is built backwards, from the end of the chain, so that
+			// each node knows where to continue
+			std::vector<const Node*> chain;
+			for( ; node != nullptr; node = node->Next )
+				chain.push_back( node );
+			entry = next;
+			for( auto i = chain.rbegin(); i != chain.rend(); ++i )
+			{
+				if( !_compileNode( **i, entry, entry ) )
+					return false;
+			}
+			return true;
+		}
+
+		bool Dfa::_compileNode( const Node& node, uint32_t next, uint32_t& entry )
+		{
+			if( node.Name || ( node.PreAnchoring != Anchor::none && node.PreAnchoring != Anchor::input ) )
+				return false;
+			auto min = node.Quant.minQ(), max = node.Quant.maxQ();
+			if( min > MaxNfaStates || ( max != INDEX_MAX && max > MaxNfaStates ) )
+				return false;
+
+			uint32_t cur = next;
+			if( max == INDEX_MAX )
+			{
+				// Loop back to a split that either goes another round or moves on
+				auto loop = _add( NfaState::kind::split );
+				uint32_t body{ 0 };
+				if( !_compileBody( node, loop, body ) )
+					return false;
+				Nfa[ loop ].Out1 = body;
+				Nfa[ loop ].Out2 = next;
+				cur = loop;
+			}
+			else
+			{
+				// Nested optional repetitions: (x(x)?)?
+				for( auto i = min; i < max; ++i )
+				{
+					uint32_t body{ 0 };
+					if( !_compileBody( node, cur, body ) )
+						return false;
+					cur = _add( NfaState::kind::split, body, next );
+				}
+			}
+			for( index_t i = 0; i < min; ++i )
+			{
+				if( !_compileBody( node, cur, cur ) )
+					return false;
+			}
+
+			if( node.PreAnchoring == Anchor::input )
+				cur = _add( NfaState::kind::start, cur );
+			entry = cur;
+			return true;
+		}
+
+		bool Dfa::_compileBody( const Node& node, uint32_t next, uint32_t& entry )
+		{
+			if( Nfa.size() > MaxNfaStates )
+				return false;
+
+			switch( node.Type )
+			{
+				case NodeType::val_fixed:
+				{
+					std::vector<char_t> chars;
+					for( auto c : static_cast<const FixedValue&>( node ).value() )
+						chars.push_back( c );
+					entry = next;
+					for( auto c = chars.rbegin(); c != chars.rend(); ++c )
+					{
+						entry = _add( NfaState::kind::chr, entry );
+						Nfa[ entry ].Chr = *c;
+					}
+					return true;
+				}
+				case NodeType::node_group:
+				case NodeType::capt_group:
+					return _compileChain( static_cast<const NodeGroup&>( node ).Head, next, entry );
+				case NodeType::op_or:
+				{
+					auto& optionals = static_cast<const OpOr&>( node ).Optionals;
+					if( optionals.empty() || !_compileChain( optionals.back(), next, entry ) )
+						return false;
+					for( auto opt = optionals.rbegin() + 1; opt != optionals.rend(); ++opt )
+					{
+						uint32_t alternative{ 0 };
+						if( !_compileChain( *opt, next, alternative ) )
+							return false;
+						entry = _add( NfaState::kind::split, alternative, entry );
+					}
+					return true;
+				}
+				case NodeType::loc_end:
+					entry = _add( NfaState::kind::end, next );
+					if( Flags & Flag::lines )
+					{
+						// End of line consumes the newline
+						auto newline = _add( NfaState::kind::chr, next );
+						Nfa[ newline ].Chr = NewlineChr;
+						entry = _add( NfaState::kind::split, entry, newline );
+					}
+					return true;
+				case NodeType::undef:
+				case NodeType::op_not:
+				case NodeType::loc_start:
+				case NodeType::loc_wordstart:
+				case NodeType::loc_wordend:
+				case NodeType::val_backref:
+					return false;
+				default:
+					return _compilePred( node, next, entry );
+			}
+		}
+
+		bool Dfa::_compilePred( const Node& node, uint32_t next, uint32_t& entry )
+		{
+			entry = _add( NfaState::kind::pred, next );
+			auto& state = Nfa[ entry ];
+			state.Pred = &node;
+			for( char_t c = 0; c < 128; ++c )
+				state.Ascii[ c ] = _matchPred( node, c, Flags );
+
+			// Some values (negated character groups) match at the end of
+			// input without consuming anything
+			string empty;
+			MatchContext context( 0 );
+			RxData data( empty.substr(), Flags, context );
+			state.AtEnd = node._match( data, nsize );
+			return true;
+		}
+
+
+
+
+		bool Dfa::_accepts( const NfaState& state, char_t c ) const
+		{
+			if( state.Kind == NfaState::kind::chr )
+				return state.Flags & Flag::icase ? std::tolower( state.Chr ) == std::tolower( c ) : state.Chr == c;
+			return c < 128 ? state.Ascii[ c ] : _matchPred( *state.Pred, c, state.Flags );
+		}
+		bool Dfa::_matchPred( const Node& node, char_t c, Flag flags ) const
+		{
+			// Let the node decide, it must consume the character
+			string chr( c );
+			MatchContext context( 0 );
+			RxData data( chr.substr(), flags, context );
+			return node._match( data, nsize ) && !data;
+		}
+
+		void Dfa::_closure( Cache& cache, uint32_t nfa_state, bool at_start, nfaset& states ) const
+		{
+			cache.Stack.push_back( nfa_state );
+			while( !cache.Stack.empty() )
+			{
+				auto id = cache.Stack.back();
+				cache.Stack.pop_back();
+				if( cache.Visited[ id ] == cache.Generation )
+					continue;
+				cache.Visited[ id ] = cache.Generation;
+				auto& state = Nfa[ id ];
+				switch( state.Kind )
+				{
+					case NfaState::kind::split:
+						cache.Stack.push_back( state.Out2 );
+						cache.Stack.push_back( state.Out1 );
+						break;
+					case NfaState::kind::start:
+						if( at_start )
+							cache.Stack.push_back( state.Out1 );
+						break;
+					default:
+						states.push_back( id );
+						break;
+				}
+			}
+		}
+
+		uint32_t Dfa::_state( Cache& cache, nfaset&& states, bool searching ) const
+		{
+			if( searching )
+				states.push_back( Searching );
+			std::sort( states.begin(), states.end() );
+			states.erase( std::unique( states.begin(), states.end() ), states.end() );
+			auto found = cache.Ids.find( states );
+			if( found != cache.Ids.end() )
+				return found->second;
+
+			auto id = static_cast<uint32_t>( cache.States.size() );
+			auto state = std::make_unique<DfaState>();
+			for( auto nfa_state : states )
+			{
+				if( nfa_state != Searching && Nfa[ nfa_state ].Kind == NfaState::kind::accept )
+				{
+					state->Accepting = true;
+					state->Patterns.push_back( Nfa[ nfa_state ].Pattern );
+				}
+			}
+			state->Nfa = states;
+			cache.States.push_back( std::move( state ) );
+			cache.Ids[ std::move( states ) ] = id;
+			return id;
+		}
+
+		uint32_t Dfa::_start( Cache& cache, bool searching, bool at_start ) const
+		{
+			auto& start = cache.Start[ searching ][ at_start ];
+			if( start == Unknown )
+			{
+				_nextGeneration( cache );
+				nfaset states;
+				_closure( cache, Entry, at_start, states );
+				start = _state( cache, std::move( states ), searching );
+			}
+			return start;
+		}
+
+		uint32_t Dfa::_step( Cache& cache, uint32_t state, char_t c ) const
+		{
+			auto& from = *cache.States[ state ];
+			if( c < 128 )
+			{
+				if( from.Ascii[ c ] != Unknown )
+					return from.Ascii[ c ];
+			}
+			else
+			{
+				auto found = from.Other.find( c );
+				if( found != from.Other.end() )
+					return found->second;
+			}
+
+			_nextGeneration( cache );
+			nfaset states;
+			bool searching = false;
+			for( auto id : from.Nfa )
+			{
+				if( id == Searching )
+				{
+					searching = true;
+					continue;
+				}
+				auto& nfa_state = Nfa[ id ];
+				if( ( nfa_state.Kind == NfaState::kind::chr || nfa_state.Kind == NfaState::kind::pred )
+					&& _accepts( nfa_state, c ) )
+					_closure( cache, nfa_state.Out1, false, states );
+			}
+
+			// When searching, a new match can start after each character
+			if( searching )
+				_closure( cache, Entry, false, states );
+
+			// Start over when the cache is full - the new state will be the
+			// first of many
+			if( cache.States.size() >= MaxDfaStates )
+			{
+				cache.clear();
+				return _state( cache, std::move( states ), searching );
+			}
+
+			auto next = _state( cache, std::move( states ), searching );
+			if( c < 128 )
+				from.Ascii[ c ] = next;
+			else
+				from.Other[ c ] = next;
+			return next;
+		}
+
+		bool Dfa::_acceptAtEnd( Cache& cache, uint32_t state ) const
+		{
+			auto& dfa_state = *cache.States[ state ];
+			if( dfa_state.AcceptAtEnd < 0 )
+			{
+				// Follow everything that can pass without consuming anything
+				// at the end of input (all the way, to find all patterns)
+				_nextGeneration( cache );
+				for( auto id : dfa_state.Nfa )
+				{
+					if( id != Searching )
+						cache.Stack.push_back( id );
+				}
+				while( !cache.Stack.empty() )
+				{
+					auto id = cache.Stack.back();
+					cache.Stack.pop_back();
+					if( cache.Visited[ id ] == cache.Generation )
+						continue;
+					cache.Visited[ id ] = cache.Generation;
+					auto& nfa_state = Nfa[ id ];
+					switch( nfa_state.Kind )
+					{
+						case NfaState::kind::accept:
+							dfa_state.PatternsAtEnd.push_back( nfa_state.Pattern );
+							break;
+						case NfaState::kind::split:
+							cache.Stack.push_back( nfa_state.Out2 );
+							cache.Stack.push_back( nfa_state.Out1 );
+							break;
+						case NfaState::kind::end:
+							cache.Stack.push_back( nfa_state.Out1 );
+							break;
+						case NfaState::kind::pred:
+							if( nfa_state.AtEnd )
+								cache.Stack.push_back( nfa_state.Out1 );
+							break;
+						default:
+							break;
+					}
+				}
+				cache.Stack.clear();
+				dfa_state.AcceptAtEnd = dfa_state.PatternsAtEnd.empty() ? 0 : 1;
+			}
+			return dfa_state.AcceptAtEnd == 1;
+		}
+
+		void Dfa::_nextGeneration( Cache& cache ) const noexcept
+		{
+			if( ++cache.Generation == 0 )
+			{
+				std::fill( cache.Visited.begin(), cache.Visited.end(), 0 );
+				cache.Generation = 1;
+			}
+		}
+	}
+}
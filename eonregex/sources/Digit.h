@@ -33,7 +33,7 @@ namespace eon
 				*static_cast<Node*>( this ) = std::move( other ); return *this; }
 
 		private:
-			inline bool _match( RxData& data, index_t steps ) override {
+			inline bool _match( RxData& data, index_t steps ) const override {
 				return string::isNumberAsciiDigit( data() ) ? data.advance() : false; }
 			inline string _strStruct() const override { return "\\d"; }
 			inline index_t _countMinCharsRemaining() noexcept override {
@@ -56,7 +56,7 @@ namespace eon
 				*static_cast<Node*>( this ) = std::move( other ); return *this; }
 
 		private:
-			inline bool _match( RxData& data, index_t steps ) override {
+			inline bool _match( RxData& data, index_t steps ) const override {
 				return data && !string::isNumberDecimalDigit( data() ) ? data.advance() : false; }
 			inline string _strStruct() const override { return "\\D"; }
 			inline index_t _countMinCharsRemaining() noexcept override {
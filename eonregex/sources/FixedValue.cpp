@@ -5,7 +5,7 @@ namespace eon
 {
 	namespace rx
 	{
-		bool FixedValue::_match( RxData& data, index_t steps )
+		bool FixedValue::_match( RxData& data, index_t steps ) const
 		{
 			RxData param_b{ data };
 
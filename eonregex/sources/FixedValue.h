@@ -40,7 +40,7 @@ namespace eon
 			inline void append( const string& value ) noexcept { Value += value; }
 
 		private:
-			bool _match( RxData& data, index_t steps ) override;
+			bool _match( RxData& data, index_t steps ) const override;
 
 			string _strStruct() const override;
 
@@ -21,16 +21,28 @@ namespace eon
 	{
 		Graph& Graph::operator=( const Graph& other )
 		{
+			clear();
 			Source = other.Source;
-			Head = other.Head->copy();
+			Head = other.Head != nullptr ? other.Head->copy() : nullptr;
 			MyFlags = other.MyFlags;
+			_finalize();
 			return *this;
 		}
 		Graph& Graph::operator=( Graph&& other ) noexcept
 		{
 			Source = std::move( other.Source );
+			clear();
 			Head = other.Head; other.Head = nullptr;
 			MyFlags = std::move( other.MyFlags );
+			NumNodes = other.NumNodes; other.NumNodes = 0;
+			Captures = std::move( other.Captures );
+			Automaton = std::move( other.Automaton );
+			Literal = std::move( other.Literal );
+			Prefix = std::move( other.Prefix );
+			Required = std::move( other.Required );
+			FirstBytes = other.FirstBytes;
+			HasFirstBytes = other.HasFirstBytes; other.HasFirstBytes = false;
+			AnchoredStart = other.AnchoredStart; other.AnchoredStart = false;
 			return *this;
 		}
 
@@ -52,14 +64,26 @@ namespace eon
 					_removeSuperfluousGroups();
 				if( !( MyFlags & Flag::no_exposing ) )
 					_exposeLiterals();
-				if( !(MyFlags & Flag::lines ) && ( MyFlags & Flag::failfast_fixed_end ) )
-					_failFastFixedEnd();
 				_countMinCharsRemaining();
+				_finalize();
+				if( ( MyFlags & Flag::dfa ) && !Automaton )
+					throw InvalidExpression( "Expression cannot be matched by DFA (flag 'd'): " + string( Source ) );
 			}
 		}
 
 
 
+		string Graph::strStruct() const
+		{
+			if( !Head )
+				return string();
+			if( Literal )
+				return ( Literal->single() ? "[literal]" : "[literal set]" ) + Head->strStruct();
+			return Head->strStruct();
+		}
+
+
+
 		void Graph::parse()
 		{
 			ParseParam param( Source );
@@ -89,6 +113,9 @@ namespace eon
 						case 'f':
 							MyFlags |= Flag::failfast_fixed_end;
 							break;
+						case 'd':
+							MyFlags |= Flag::dfa;
+							break;
 						case '!':
 							_not_ = true;
 							break;
@@ -114,6 +141,15 @@ namespace eon
 						case 'e':
 							MyFlags |= Flag::no_exposing;
 							break;
+						case 'd':
+							MyFlags |= Flag::no_dfa;
+							break;
+						case 'p':
+							MyFlags |= Flag::no_prefilter;
+							break;
+						case 'l':
+							MyFlags |= Flag::no_literal;
+							break;
 						default:
 							invalid.push_back( string( "!" ) << c );
 							break;
@@ -431,7 +467,7 @@ namespace eon
 								prev = -1;
 							}
 							param.advance();
-							return new CharGroup( std::move( value ), substring( start, param.pos() ) );
+							return new CharGroup( std::move( value ), substring( start, param.pos() ), MyFlags & Flag::icase );
 						case '-':
 							if( prev == -1 )
 								value.Chars.insert( c );
@@ -800,5 +836,62 @@ namespace eon
 			Head = Head->_exposeLiterals(); }
 		void Graph::_failFastFixedEnd() {
 			Head->_failFastFixedEnd( *Head ); }
+		void Graph::_finalize()
+		{
+			NumNodes = 0;
+			if( Head )
+			{
+				if( !( MyFlags & Flag::lines ) && ( MyFlags & Flag::failfast_fixed_end ) )
+					_failFastFixedEnd();
+				auto captures = std::make_shared<CaptureSlots>();
+				Head->_finalize( NumNodes, *captures );
+				Captures = std::move( captures );
+
+				if( ( MyFlags & Flag::dfa ) || !( MyFlags & Flag::no_dfa ) )
+				{
+					Automaton = std::make_unique<Dfa>();
+					if( !Automaton->compile( *Head, MyFlags ) )
+						Automaton.reset();
+				}
+				if( !( MyFlags & Flag::no_literal ) )
+				{
+					Literal = std::make_unique<LiteralMatcher>();
+					if( !Literal->compile( *Head, MyFlags ) )
+						Literal.reset();
+				}
+				if( !( MyFlags & Flag::no_prefilter ) )
+					_findLiterals();
+			}
+		}
+
+		void Graph::_findLiterals()
+		{
+			// Every node in the main chain must be matched, in order
+			if( !( MyFlags & Flag::icase ) )
+			{
+				for( auto node = Head; node != nullptr; node = node->Next )
+				{
+					if( node->Type == NodeType::val_fixed && node->Quant.minQ() > 0 )
+					{
+						auto& value = static_cast<FixedValue*>( node )->value();
+						if( node == Head && node->PreAnchoring == Anchor::none )
+							Prefix = value;
+						if( value.numBytes() > Required.numBytes() )
+							Required = value;
+					}
+				}
+			}
+			AnchoredStart = Head->PreAnchoring & Anchor::input;
+			std::array<bool, 256> first_bytes;
+			if( Automaton && ( HasFirstBytes = Automaton->firstBytes( first_bytes ) ) )
+			{
+				FirstBytes.clear();
+				for( int byte = 0; byte < 256; ++byte )
+				{
+					if( first_bytes[ byte ] )
+						FirstBytes.set( static_cast<byte_t>( byte ) );
+				}
+			}
+		}
 	}
 }
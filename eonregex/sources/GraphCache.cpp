@@ -0,0 +1,103 @@
+#include "../GraphCache.h"
+
+
+namespace eon
+{
+	namespace rx
+	{
+		GraphCache& GraphCache::get()
+		{
+			static GraphCache cache;
+			return cache;
+		}
+
+
+		std::shared_ptr<const Graph> GraphCache::graph( const string& pattern, const string& flags )
+		{
+			auto key = _key( pattern, flags );
+			{
+				std::lock_guard<std::mutex> lock( Lock );
+				auto found = Index.find( key );
+				if( found != Index.end() )
+				{
+					++Hits;
+					Lru.splice( Lru.begin(), Lru, found->second );
+					auto& entry = found->second->second;
+					return std::shared_ptr<const Graph>( entry, &entry->Expression );
+				}
+			}
+
+			// Parse without holding the lock, other threads may be parsing
+			// the same expression, first one to finish wins
+			++Misses;
+			auto entry = std::make_shared<Entry>();
+			entry->Pattern = pattern;
+			entry->Flags = flags;
+			entry->Expression.parse( entry->Pattern.substr(), entry->Flags.substr() );
+			std::shared_ptr<const Entry> result = entry;
+
+			std::lock_guard<std::mutex> lock( Lock );
+			if( Capacity > 0 )
+			{
+				auto found = Index.find( key );
+				if( found != Index.end() )
+					result = found->second->second;
+				else
+				{
+					Lru.push_front( std::make_pair( std::move( key ), result ) );
+					Index[ Lru.front().first ] = Lru.begin();
+					_trim();
+				}
+			}
+			return std::shared_ptr<const Graph>( result, &result->Expression );
+		}
+
+
+		void GraphCache::capacity( index_t max_graphs )
+		{
+			std::lock_guard<std::mutex> lock( Lock );
+			Capacity = max_graphs;
+			_trim();
+		}
+		index_t GraphCache::capacity() const
+		{
+			std::lock_guard<std::mutex> lock( Lock );
+			return Capacity;
+		}
+
+		index_t GraphCache::size() const
+		{
+			std::lock_guard<std::mutex> lock( Lock );
+			return static_cast<index_t>( Index.size() );
+		}
+
+		void GraphCache::clear()
+		{
+			std::lock_guard<std::mutex> lock( Lock );
+			Index.clear();
+			Lru.clear();
+		}
+
+
+
+
+		std::string GraphCache::_key( const string& pattern, const string& flags )
+		{
+			// Length of flags first, so there is no ambiguity
+			std::string key = std::to_string( flags.numBytes() ) + ":";
+			key.reserve( key.size() + flags.numBytes() + pattern.numBytes() );
+			key.append( flags.c_str(), flags.numBytes() );
+			key.append( pattern.c_str(), pattern.numBytes() );
+			return key;
+		}
+
+		void GraphCache::_trim()
+		{
+			while( Index.size() > Capacity )
+			{
+				Index.erase( Lru.back().first );
+				Lru.pop_back();
+			}
+		}
+	}
+}
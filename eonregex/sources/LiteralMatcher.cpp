@@ -0,0 +1,170 @@
+#include "../LiteralMatcher.h"
+#include "../NodeGroup.h"
+#include "../OpOr.h"
+#include "FixedValue.h"
+#include <algorithm>
+#include <cstring>
+
+
+namespace eon
+{
+	namespace rx
+	{
+		bool LiteralMatcher::compile( const Node& head, Flag flags )
+		{
+			Values.clear();
+			Index.clear();
+			Lengths.clear();
+			FirstBytes.clear();
+			if( ( flags & Flag::icase ) || ( flags & Flag::lines ) )
+				return false;
+			if( head.PreAnchoring != Anchor::none && head.PreAnchoring != Anchor::input )
+				return false;
+			AtStart = head.PreAnchoring == Anchor::input;
+			Longest = flags & Flag::dfa;
+
+			// Optionally followed by end of input
+			AtEnd = head.Next != nullptr;
+			if( AtEnd && ( head.Next->Type != NodeType::loc_end || head.Next->Next != nullptr
+				|| head.Next->Quant.minQ() != 1 || head.Next->Quant.maxQ() != 1 ) )
+				return false;
+
+			// A literal or alternatives of literals, possibly grouped
+			if( head.Name || head.Quant.minQ() != 1 || head.Quant.maxQ() != 1 )
+				return false;
+			auto body = &head;
+			if( body->Type == NodeType::node_group )
+			{
+				body = static_cast<const NodeGroup*>( body )->Head;
+				if( body == nullptr || body->Next != nullptr || body->PreAnchoring != Anchor::none )
+					return false;
+			}
+			if( body->Type == NodeType::op_or )
+			{
+				for( auto opt : static_cast<const OpOr*>( body )->Optionals )
+				{
+					if( opt->Next != nullptr || opt->PreAnchoring != Anchor::none || !_add( *opt ) )
+						return false;
+				}
+			}
+			else if( !_add( *body ) )
+				return false;
+
+			// The index refers to the values, so they must all be in place
+			for( index_t i = 0; i < Values.size(); ++i )
+			{
+				auto& bytes = Values[ i ].Bytes;
+				Index.emplace( std::string_view( bytes ), i );
+				Lengths.push_back( bytes.size() );
+				FirstBytes.set( static_cast<byte_t>( bytes[ 0 ] ) );
+			}
+			std::sort( Lengths.begin(), Lengths.end() );
+			Lengths.erase( std::unique( Lengths.begin(), Lengths.end() ), Lengths.end() );
+			return true;
+		}
+
+
+
+
+		LiteralMatcher::Found LiteralMatcher::match( const char* pos, const char* end, bool at_start ) const noexcept
+		{
+			if( AtStart && !at_start )
+				return Found();
+			return _match( pos, end );
+		}
+
+		LiteralMatcher::Found LiteralMatcher::findFirst(
+			const char* begin, const char* end, bool at_start ) const noexcept
+		{
+			if( AtStart )
+				return at_start ? _match( begin, end ) : Found();
+
+			// Only the positions where a literal ends at the end of input
+			// can match, leftmost first
+			if( AtEnd )
+			{
+				for( auto length = Lengths.rbegin(); length != Lengths.rend(); ++length )
+				{
+					if( *length > static_cast<size_t>( end - begin ) )
+						continue;
+					auto found = _match( end - *length, end );
+					if( found )
+						return found;
+				}
+				return Found();
+			}
+
+			if( single() )
+			{
+				auto& value = Values[ 0 ];
+				std::string_view area( begin, end - begin );
+				auto pos = area.find( value.Bytes );
+				if( pos == std::string_view::npos )
+					return Found();
+				return Found{ begin + pos, begin + pos + value.Bytes.size(), value.NumChars };
+			}
+
+			for( auto pos = FirstBytes.findFirstIn( begin, end ); pos != end;
+				pos = FirstBytes.findFirstIn( pos + 1, end ) )
+			{
+				auto found = _match( pos, end );
+				if( found )
+					return found;
+			}
+			return Found();
+		}
+
+
+
+
+		bool LiteralMatcher::_add( const Node& node )
+		{
+			if( node.Type != NodeType::val_fixed || node.Name || node.Quant.minQ() != 1 || node.Quant.maxQ() != 1 )
+				return false;
+			auto& value = static_cast<const FixedValue&>( node ).value();
+			if( value.empty() )
+				return false;
+			Values.push_back( Value{ std::string( value.c_str(), value.numBytes() ), value.numChars() } );
+			return true;
+		}
+
+		LiteralMatcher::Found LiteralMatcher::_match( const char* pos, const char* end ) const noexcept
+		{
+			auto remaining = static_cast<size_t>( end - pos );
+			const Value* best{ nullptr };
+			if( single() )
+			{
+				auto& value = Values[ 0 ];
+				if( value.Bytes.size() <= remaining && memcmp( pos, value.Bytes.c_str(), value.Bytes.size() ) == 0 )
+					best = &value;
+			}
+			else if( AtEnd && Longest )
+			{
+				// Only a literal ending at the end of input will do
+				auto found = Index.find( std::string_view( pos, remaining ) );
+				if( found != Index.end() )
+					best = &Values[ found->second ];
+			}
+			else
+			{
+				index_t best_alternative{ nsize };
+				for( auto length : Lengths )
+				{
+					if( length > remaining )
+						break;
+					auto found = Index.find( std::string_view( pos, length ) );
+					if( found != Index.end() && ( Longest || found->second < best_alternative ) )
+						best_alternative = found->second;
+				}
+				if( best_alternative != nsize )
+					best = &Values[ best_alternative ];
+			}
+
+			// The first alternative is committed to, even if it doesn't end
+			// where it must
+			if( best == nullptr || ( AtEnd && best->Bytes.size() != remaining ) )
+				return Found();
+			return Found{ pos, pos + best->Bytes.size(), best->NumChars };
+		}
+	}
+}
@@ -33,7 +33,7 @@ namespace eon
 				*static_cast<Node*>( this ) = std::move( other ); return *this; }
 
 		private:
-			inline bool _match( RxData& param, index_t steps ) override {
+			inline bool _match( RxData& param, index_t steps ) const override {
 				return !param ? true : param.pos() == param.source().end() ? true
 					: ( param.lines() && param() == '\n' ) ? param.advance() : false; }
 			inline string _strStruct() const override { return "$"; }
@@ -1,6 +1,7 @@
 #include "../Node.h"
 #include "../NodeGroup.h"
 #include "FixedValue.h"
+#include "../CharGroup.h"
 
 
 namespace eon
@@ -9,10 +10,10 @@ namespace eon
 	{
 		Node& Node::operator=( const Node& other )
 		{
-			Matched = other.Matched;
+			Id = other.Id;
 			Next = other.Next != nullptr ? other.Next->copy() : nullptr;
 			Group = nullptr;
-			FixedEnd = other.FixedEnd;
+			FixedEnd = nullptr;		// Must be set for the new graph!
 			MinCharsRemaining = other.MinCharsRemaining;
 			Quant = other.Quant;
 			Name = other.Name;
@@ -20,12 +21,11 @@ namespace eon
 			Source = other.Source;
 			Type = other.Type;
 			PreAnchoring = other.PreAnchoring;
-			PrevPos = other.PrevPos;
 			return *this;
 		}
 		Node& Node::operator=( Node&& other ) noexcept
 		{
-			Matched = std::move( other.Matched );
+			Id = other.Id;
 			Next = other.Next; other.Next = nullptr;
 			Group= nullptr;
 			FixedEnd = other.FixedEnd; other.FixedEnd = nullptr;
@@ -36,20 +36,22 @@ namespace eon
 			Source = other.Source; other.Source.clear();
 			Type = other.Type;
 			PreAnchoring = other.PreAnchoring; other.PreAnchoring = Anchor::none;
-			PrevPos = other.PrevPos;
 			return *this;
 		}
 
 
 
 
-		bool Node::match( RxData& data, index_t steps )
+		bool Node::match( RxData& data, index_t steps ) const
 		{
+			EON_RX_STATS( if( data.context().counts() ) ++data.context().counts()->NodeVisits; )
+
 			// If this node has already been successfully matched, don't try again!
-			if( _matched() )
+			auto& matched = _state( data ).Matched;
+			if( matched.source() )
 			{
-				Matched.addCaptures( data.captures() );
-				data = Matched;
+				matched.addCaptures( data );
+				data = matched;
 				return true;
 			}
 
@@ -57,14 +59,14 @@ namespace eon
 			// pattern, we can report failure right now!
 			if( data.remaining() < MinCharsRemaining )
 			{
-				_unmatch();
+				_unmatch( data.context() );
 				return false;
 			}
 
 			// Check anchors
 			if( PreAnchoring != Anchor::none && !_preAnchorMatch( data ) )
 			{
-				_unmatch();
+				_unmatch( data.context() );
 				return false;
 			}
 
@@ -75,7 +77,7 @@ namespace eon
 				if( endvalue->value().substr() != substring(
 					data.source().end() - endvalue->value().numChars(), data.source().end() ) )
 				{
-					_unmatch();
+					_unmatch( data.context() );
 					return false;
 				}
 			}
@@ -97,9 +99,9 @@ namespace eon
 				success = _matchRangeNongreedy( data, steps );
 
 			if( success )
-				Matched = data;
+				_state( data ).Matched = data;
 			else
-				_unmatch();
+				_unmatch( data.context() );
 			return success;
 		}
 
@@ -114,9 +116,16 @@ namespace eon
 			}
 		}
 
+		void Node::_finalize( index_t& num_nodes, CaptureSlots& captures )
+		{
+			Id = num_nodes++;
+			if( Next )
+				Next->_finalize( num_nodes, captures );
+		}
+
 
 
-		bool Node::_matchSingle( RxData& data, index_t steps )
+		bool Node::_matchSingle( RxData& data, index_t steps ) const
 		{
 			RxData data_tmp{ data };
 
@@ -139,7 +148,7 @@ namespace eon
 			data = std::move( data_tmp );
 			return true;
 		}
-		bool Node::_matchOneOrZero( RxData& data, index_t steps )
+		bool Node::_matchOneOrZero( RxData& data, index_t steps ) const
 		{
 			// Try to match one first
 			if( _matchSingle( data, steps ) )
@@ -148,6 +157,7 @@ namespace eon
 			// That's OK, now we try to match zero
 			if( Next != nullptr )
 			{
+				EON_RX_STATS( _countBacktrack( data ); )
 				RxData data_tmp{ data };
 				if( Next->match( data_tmp, steps ) )
 				{
@@ -159,11 +169,12 @@ namespace eon
 			else
 				return true;
 		}
-		bool Node::_matchRangeGreedy( RxData& data, index_t steps )
+		bool Node::_matchRangeGreedy( RxData& data, index_t steps ) const
 		{
-			if( PrevPos.same( data.pos(), data.marker() ) )
+			auto& prev_pos = _state( data ).PrevPos;
+			if( prev_pos.same( data.pos(), data.marker() ) )
 				return false;
-			PrevPos.mark( data.pos(), data.marker() );
+			prev_pos.mark( data.pos(), data.marker() );
 
 			// Match as many as possible from the start
 			auto matches = _stack();
@@ -183,7 +194,7 @@ namespace eon
 			// (backgrack) until they do
 			return _matchNext( data, matches );
 		}
-		void Node::_matchMax( Stack& matches, index_t steps )
+		void Node::_matchMax( Stack& matches, index_t steps ) const
 		{
 			// Some special cases can be processed faster
 			if( _matchSpecialCase( matches ) )
@@ -192,7 +203,7 @@ namespace eon
 			matches.push( matches.top() );
 			while( true )
 			{
-				_unmatch();
+				_unmatch( matches.top().context() );
 				if( !_match( matches.top(), steps ) )
 				{
 					matches.pop();
@@ -205,18 +216,20 @@ namespace eon
 				matches.push( matches.top() );
 			}
 		}
-		bool Node::_matchSpecialCase( Stack& matches )
+		bool Node::_matchSpecialCase( Stack& matches ) const
 		{
 			switch( Type )
 			{
 				case NodeType::val_any:
 					_matchAny( matches );
 					return true;
+				case NodeType::val_chargroup:
+					return _matchAscii( matches, static_cast<const CharGroup*>( this )->ascii() );
 				default:
 					return false;
 			}
 		}
-		void Node::_matchAny( Stack& matches )
+		void Node::_matchAny( Stack& matches ) const
 		{
 			// Goble as much as we can
 			index_t gobbled{ 0 };
@@ -231,7 +244,23 @@ namespace eon
 					return;
 			}
 		}
-		bool Node::_noNext( RxData& data, Stack& matches )
+		bool Node::_matchAscii( Stack& matches, const ByteSet& chars ) const
+		{
+			// Skip the run of ASCII characters in the set, the rest (if any)
+			// is matched one at a time
+			auto& top = matches.top();
+			if( !top || !top.pos().validUTF8() )
+				return false;
+			auto start = top.pos().byteData();
+			auto run = chars.findFirstNotIn( start, top.source().end().byteData() ) - start;
+			for( ; run > 0 && matches.size() <= Quant.maxQ(); --run )
+			{
+				matches.push( matches.top() );
+				matches.top().advance();
+			}
+			return matches.size() > Quant.maxQ();
+		}
+		bool Node::_noNext( RxData& data, Stack& matches ) const
 		{
 			if( matches.size() >= Quant.minQ() )
 			{
@@ -241,7 +270,7 @@ namespace eon
 			}
 			return false;
 		}
-		bool Node::_matchNext( RxData& data, Stack& matches )
+		bool Node::_matchNext( RxData& data, Stack& matches ) const
 		{
 			// 'matches' is a stack of RxData objects where the bottom element
 			// is the start of the current potential greedy match and the top
@@ -260,6 +289,7 @@ namespace eon
 				else
 				{
 					// Didn't get match, pop the stack
+					EON_RX_STATS( _countBacktrack( data ); )
 					matches.pop();
 
 					if( matches.empty() )
@@ -277,7 +307,7 @@ namespace eon
 				return true;
 			return false;
 		}
-		bool Node::_matchRangeNongreedy( RxData& data, index_t steps )
+		bool Node::_matchRangeNongreedy( RxData& data, index_t steps ) const
 		{
 			// Match as few as possible from the start
 			RxData data_tmp{ data };
@@ -318,7 +348,8 @@ namespace eon
 				else
 				{
 					// Didn't get a match, try matching this again
-					_unmatch();
+					EON_RX_STATS( _countBacktrack( data ); )
+					_unmatch( data_tmp.context() );
 					if( !_match( data_tmp, steps ) )
 						return false;
 					++matches;
@@ -326,14 +357,14 @@ namespace eon
 			}
 			return false;
 		}
-		bool Node::_matchNext( RxData& data, index_t steps )
+		bool Node::_matchNext( RxData& data, index_t steps ) const
 		{
 			if( Next == nullptr )
 				return true;
 			return Next->match( data, steps );
 		}
 
-		bool Node::_preAnchorMatch( RxData& data )
+		bool Node::_preAnchorMatch( RxData& data ) const
 		{
 			if( !data() )			// End of input cannot be start of anything
 				return false;
@@ -5,12 +5,11 @@ namespace eon
 {
 	namespace rx
 	{
-		bool NodeGroup::_match( RxData& data, index_t steps )
+		bool NodeGroup::_match( RxData& data, index_t steps ) const
 		{
 			if( Head != nullptr )
 			{
 				RxData param_b{ data };
-				Head->_setGroup( this );
 				if( Head->match( param_b, steps ) )
 				{
 					data = std::move( param_b );
@@ -55,6 +54,16 @@ namespace eon
 				Next->_failFastFixedEnd( head );
 		}
 
+		void NodeGroup::_finalize( index_t& num_nodes, CaptureSlots& captures )
+		{
+			Node::_finalize( num_nodes, captures );
+			if( Head )
+			{
+				Head->_setGroup( this );
+				Head->_finalize( num_nodes, captures );
+			}
+		}
+
 		void NodeGroup::_append( Node* node ) noexcept
 		{
 			if( !_locked() )
@@ -40,8 +40,11 @@ namespace eon
 					return Value->equal( *o.Value, cmpflag::deep | cmpflag::quant ); else return Value == o.Value; }
 
 		private:
-			inline bool _match( RxData& data, index_t steps ) override { return !Value->match( data, steps ); }
-			void _unmatch() noexcept override { if( Value->_matched() ) Value->_unmatch(); Node::_unmatch(); }
+			inline bool _match( RxData& data, index_t steps ) const override { return !Value->match( data, steps ); }
+			void _unmatch( MatchContext& context ) const noexcept override {
+				if( Value->_matched( context ) ) Value->_unmatch( context ); Node::_unmatch( context ); }
+			inline void _finalize( index_t& num_nodes, CaptureSlots& captures ) override {
+				Node::_finalize( num_nodes, captures ); if( Value ) Value->_finalize( num_nodes, captures ); }
 			inline string _strStruct() const override { return Value ? "!" + Value->strStruct() : "!"; }
 			inline void _removeDuplicates() override { if( Value ) Value->removeDuplicates(); }
 			inline void _combinedFixed() override { if( Value ) Value->combineFixed(); }
@@ -17,11 +17,12 @@ namespace eon
 
 
 
-		bool OpOr::_match( RxData& data, index_t steps )
+		bool OpOr::_match( RxData& data, index_t steps ) const
 		{
 			RxData data_b{ data };
 			for( auto& opt : Optionals )
 			{
+				EON_RX_STATS( if( &opt != &Optionals.front() ) _countBacktrack( data ); )
 				if( opt->match( data_b, steps ) )
 				{
 					data = std::move( data_b );
@@ -63,5 +64,11 @@ namespace eon
 			if( Next )
 				Next->_failFastFixedEnd( head );
 		}
+		void OpOr::_finalize( index_t& num_nodes, CaptureSlots& captures )
+		{
+			Node::_finalize( num_nodes, captures );
+			for( auto& opt : Optionals )
+				opt->_finalize( num_nodes, captures );
+		}
 	}
 }
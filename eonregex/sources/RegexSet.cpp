@@ -0,0 +1,100 @@
+#include "../RegexSet.h"
+
+
+namespace eon
+{
+	namespace rx
+	{
+		regex_set& regex_set::operator=( const regex_set& other )
+		{
+			if( this != &other )
+			{
+				// The engine cannot be copied, but is cheap to build again
+				clear();
+				for( auto& expression : other.Expressions )
+					add( expression );
+			}
+			return *this;
+		}
+
+
+		index_t regex_set::add( const regex& expression )
+		{
+			auto number = static_cast<index_t>( Expressions.size() );
+			Expressions.push_back( expression );
+			auto& graph = Expressions.back().Graph;
+			bool combined = false;
+			if( graph && graph->dfa() != nullptr )
+			{
+				if( !Automaton )
+					Automaton = std::make_unique<Dfa>();
+				combined = Automaton->add(
+					*graph->head(), graph->flags(), static_cast<uint32_t>( number ) );
+			}
+			Combined.push_back( combined );
+			return number;
+		}
+
+		void regex_set::clear() noexcept
+		{
+			Expressions.clear();
+			Combined.clear();
+			Automaton.reset();
+		}
+
+
+
+
+		std::vector<index_t> regex_set::matches( const substring& str ) const
+		{
+			std::vector<index_t> found;
+			if( str.empty() )
+				return found;
+			std::vector<bool> candidates( Expressions.size(), false );
+			_candidates( str, candidates );
+			for( index_t i = 0; i < Expressions.size(); ++i )
+			{
+				auto& expression = Expressions[ i ];
+				if( Combined[ i ] )
+				{
+					// The engine is exact for expressions matched by DFA only
+					if( candidates[ i ] && ( expression._dfaOnly() || expression.findFirst( str ) ) )
+						found.push_back( i );
+				}
+				else if( expression.findFirst( str ) )
+					found.push_back( i );
+			}
+			return found;
+		}
+
+		std::vector<std::pair<index_t, match>> regex_set::findFirst( const substring& str ) const
+		{
+			std::vector<std::pair<index_t, match>> found;
+			if( str.empty() )
+				return found;
+			std::vector<bool> candidates( Expressions.size(), false );
+			_candidates( str, candidates );
+			for( index_t i = 0; i < Expressions.size(); ++i )
+			{
+				if( Combined[ i ] && !candidates[ i ] )
+					continue;
+				auto result = Expressions[ i ].findFirst( str );
+				if( result )
+					found.push_back( std::make_pair( i, std::move( result ) ) );
+			}
+			return found;
+		}
+
+
+
+
+		void regex_set::_candidates( const substring& str, std::vector<bool>& candidates ) const
+		{
+			if( Automaton && Automaton->numPatterns() > 0 )
+			{
+				Dfa::Runner runner( *Automaton );
+				runner.searchAll( str, candidates );
+			}
+		}
+	}
+}
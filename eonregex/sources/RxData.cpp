@@ -5,15 +5,63 @@ namespace eon
 {
 	namespace rx
 	{
-		substring RxData::findCapture( name_t name ) const noexcept
+		RxData::RxData( const substring& source, Flag flags, MatchContext& context ) noexcept
 		{
-			if( Captures )
+			Src = source;
+			Pos = Src.begin();
+			CmpFlags = flags;
+			Marker = context.newMarker();
+			Ctx = &context;
+		}
+
+		substring RxData::findCapture( index_t slot ) const noexcept
+		{
+			for( auto i = LastCapture; i != NoCapture; )
 			{
-				auto found = Captures->find( name );
-				if( found != Captures->end() )
-					return found->second;
+				auto& record = Ctx->capture( i );
+				if( record.Slot == slot )
+					return record.Value;
+				i = record.Prev;
 			}
 			return substring();
 		}
+
+		void RxData::addCaptures( const RxData& other )
+		{
+			// Add the latest capture of each slot in 'other', once
+			auto original = LastCapture, first_added = NoCapture;
+			for( auto i = other.LastCapture; i != NoCapture && i != original; )
+			{
+				auto record = Ctx->capture( i );
+				bool added = false;
+				for( auto j = LastCapture; first_added != NoCapture && j != NoCapture && j >= first_added;
+					j = Ctx->capture( j ).Prev )
+				{
+					if( Ctx->capture( j ).Slot == record.Slot )
+					{
+						added = true;
+						break;
+					}
+				}
+				if( !added )
+				{
+					registerCapture( record.Slot, record.Value );
+					if( first_added == NoCapture )
+						first_added = LastCapture;
+				}
+				i = record.Prev;
+			}
+		}
+
+		void RxData::captures( std::vector<substring>& slots ) const
+		{
+			for( auto i = LastCapture; i != NoCapture; )
+			{
+				auto& record = Ctx->capture( i );
+				if( record.Slot < slots.size() && !slots[ record.Slot ].hasSource() )
+					slots[ record.Slot ] = record.Value;
+				i = record.Prev;
+			}
+		}
 	}
 }
@@ -0,0 +1,131 @@
+#include "../Scanner.h"
+
+
+namespace eon
+{
+	regex::scanner::scanner( const regex& expression, callback found, size_t max_match )
+		: Expr( expression ), Found( std::move( found ) )
+	{
+		// Room for at least one (UTF-8) character
+		MaxMatch = std::max( max_match, static_cast<size_t>( 4 ) );
+	}
+
+
+
+
+	void regex::scanner::feed( const char* bytes, size_t size )
+	{
+		if( Stopped || Finished )
+			return;
+		Pending.append( bytes, size );
+		NumBytes += size;
+		_scan( false );
+	}
+
+	void regex::scanner::finish()
+	{
+		if( Stopped || Finished )
+			return;
+		_scan( true );
+		Finished = true;
+		Pending.clear();
+	}
+
+
+	void regex::scanner::scan( source::Raw& source, size_t chunk_size )
+	{
+		std::string chunk;
+		chunk.reserve( chunk_size );
+		for( index_t pos = 0, end = source.numBytesInSource(); pos < end && !Stopped; )
+		{
+			chunk.clear();
+			for( ; pos < end && chunk.size() < chunk_size; ++pos )
+				chunk += static_cast<char>( source.byte( pos ) );
+			feed( chunk );
+		}
+		finish();
+	}
+
+	void regex::scanner::scan( const reader& read, size_t chunk_size )
+	{
+		std::vector<char> chunk( chunk_size > 0 ? chunk_size : 1 );
+		while( !Stopped )
+		{
+			auto size = read( chunk.data(), chunk.size() );
+			if( size == 0 )
+				break;
+			feed( chunk.data(), size );
+		}
+		finish();
+	}
+
+
+
+
+	void regex::scanner::_scan( bool final )
+	{
+		while( !Stopped )
+		{
+			// Unless this is the end of the input, we need a full window:
+			// Matches starting in the first half are certain (as long as they
+			// are shorter than the maximum), the rest will be searched again
+			// in the next window.
+			auto complete = final ? Pending.size() : _complete();
+			if( complete <= Behind || ( !final && complete - Behind < 2 * MaxMatch ) )
+				return;
+			auto window_end = final ? complete : _charStart( Behind + 2 * MaxMatch );
+			auto limit = final ? complete : _charStart( Behind + MaxMatch );
+
+			string window( std::string( Pending.c_str(), window_end ) );
+			auto start = window.begin();
+			if( Behind > 0 )
+				start = string::iterator( window.begin(), window.c_str() + Behind, 1 );
+			auto pos = start;
+			while( pos != window.end() )
+			{
+				auto found = Expr.findFirst( substring( pos, window.end() ) );
+				if( !found || found.all().begin().byteData() >= window.c_str() + limit )
+					break;
+				auto all = found.all();
+				++NumMatches;
+				if( !Found( Offset + ( all.begin().byteData() - window.c_str() ), found ) )
+				{
+					Stopped = true;
+					return;
+				}
+				pos = all.end();
+				if( all.empty() )
+					++pos;
+			}
+
+			// Drop what has been searched, except for the last character
+			size_t next = std::max( limit, static_cast<size_t>( pos.byteData() - window.c_str() ) );
+			auto keep = next > 0 ? _charStart( next - 1 ) : 0;
+			Pending.erase( 0, keep );
+			Offset += keep;
+			Behind = next - keep;
+			if( final )
+				return;
+		}
+	}
+
+	size_t regex::scanner::_complete() const noexcept
+	{
+		// Find the start of the last character, and see if all of it is there
+		auto start = _charStart( Pending.size() > 0 ? Pending.size() - 1 : 0 );
+		if( start == Pending.size() )
+			return start;
+		auto lead = static_cast<byte_t>( Pending[ start ] );
+		size_t length = lead < 0x80 ? 1 : lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 1;
+		return start + length <= Pending.size() ? start + length : start;
+	}
+
+	size_t regex::scanner::_charStart( size_t pos ) const noexcept
+	{
+		// Back up over continuation bytes (at most three)
+		for( int i = 0; i < 3 && pos > Behind && pos < Pending.size()
+			&& ( static_cast<byte_t>( Pending[ pos ] ) & 0xC0 ) == 0x80; ++i )
+			--pos;
+		return pos;
+	}
+}
@@ -33,7 +33,7 @@ namespace eon
 				*static_cast<Node*>( this ) = std::move( other ); return *this; }
 
 		private:
-			inline bool _match( RxData& data, index_t steps ) override {
+			inline bool _match( RxData& data, index_t steps ) const override {
 				return string::isSpaceChar( data() ) ? data.advance() : false; }
 			inline string _strStruct() const override { return "\\s"; }
 			inline index_t _countMinCharsRemaining() noexcept override {
@@ -55,7 +55,7 @@ namespace eon
 				*static_cast<Node*>( this ) = std::move( other ); return *this; }
 
 		private:
-			inline bool _match( RxData& data, index_t steps ) override {
+			inline bool _match( RxData& data, index_t steps ) const override {
 				return data && !string::isSpaceChar( data() ) ? data.advance() : false; }
 			inline string _strStruct() const override { return "\\S"; }
 			inline index_t _countMinCharsRemaining() noexcept override {
@@ -80,7 +80,7 @@ namespace eon
 				*static_cast<Node*>( this ) = std::move( other ); return *this; }
 
 		private:
-			inline bool _match( RxData& data, index_t steps ) override {
+			inline bool _match( RxData& data, index_t steps ) const override {
 				return string::isPunctuation( data() ) ? data.advance() : false; }
 			inline string _strStruct() const override { return "\\p"; }
 			inline index_t _countMinCharsRemaining() noexcept override {
@@ -104,7 +104,7 @@ namespace eon
 				noexcept { *static_cast<Node*>( this ) = std::move( other ); return *this; }
 
 		private:
-			inline bool _match( RxData& data, index_t steps ) override {
+			inline bool _match( RxData& data, index_t steps ) const override {
 				return data && !string::isPunctuation( data() ) ? data.advance() : false; }
 			inline string _strStruct() const override { return "\\P"; }
 			inline index_t _countMinCharsRemaining() noexcept override {
@@ -0,0 +1,71 @@
+#include "../Stats.h"
+
+
+namespace eon
+{
+	namespace rx
+	{
+		Stats& Stats::operator+=( const Stats& other ) noexcept
+		{
+			Calls += other.Calls;
+			Rejected += other.Rejected;
+			Skipped += other.Skipped;
+			Attempts += other.Attempts;
+			NodeVisits += other.NodeVisits;
+			Backtracks += other.Backtracks;
+			Captures += other.Captures;
+			return *this;
+		}
+
+		string Stats::str() const
+		{
+			string s;
+			s << "calls=" << string::toString( Calls ) << "\n";
+			s << "rejected=" << string::toString( Rejected ) << "\n";
+			s << "skipped=" << string::toString( Skipped ) << "\n";
+			s << "attempts=" << string::toString( Attempts ) << "\n";
+			s << "node_visits=" << string::toString( NodeVisits ) << "\n";
+			s << "backtracks=" << string::toString( Backtracks ) << "\n";
+			s << "captures=" << string::toString( Captures ) << "\n";
+			return s;
+		}
+
+
+
+
+		void StatsCounter::add( const Stats& stats ) noexcept
+		{
+			Calls.fetch_add( stats.Calls, std::memory_order_relaxed );
+			Rejected.fetch_add( stats.Rejected, std::memory_order_relaxed );
+			Skipped.fetch_add( stats.Skipped, std::memory_order_relaxed );
+			Attempts.fetch_add( stats.Attempts, std::memory_order_relaxed );
+			NodeVisits.fetch_add( stats.NodeVisits, std::memory_order_relaxed );
+			Backtracks.fetch_add( stats.Backtracks, std::memory_order_relaxed );
+			Captures.fetch_add( stats.Captures, std::memory_order_relaxed );
+		}
+
+		Stats StatsCounter::get() const noexcept
+		{
+			Stats stats;
+			stats.Calls = Calls.load( std::memory_order_relaxed );
+			stats.Rejected = Rejected.load( std::memory_order_relaxed );
+			stats.Skipped = Skipped.load( std::memory_order_relaxed );
+			stats.Attempts = Attempts.load( std::memory_order_relaxed );
+			stats.NodeVisits = NodeVisits.load( std::memory_order_relaxed );
+			stats.Backtracks = Backtracks.load( std::memory_order_relaxed );
+			stats.Captures = Captures.load( std::memory_order_relaxed );
+			return stats;
+		}
+
+		void StatsCounter::reset() noexcept
+		{
+			Calls = 0;
+			Rejected = 0;
+			Skipped = 0;
+			Attempts = 0;
+			NodeVisits = 0;
+			Backtracks = 0;
+			Captures = 0;
+		}
+	}
+}
@@ -33,7 +33,7 @@ namespace eon
 				*static_cast<Node*>( this ) = std::move( other ); return *this; }
 
 		private:
-			inline bool _match( RxData& data, index_t steps ) override {
+			inline bool _match( RxData& data, index_t steps ) const override {
 				return string::isWordChar( data() ) ? data.advance() : false; }
 			inline string _strStruct() const override { return "\\w"; }
 			inline index_t _countMinCharsRemaining() noexcept override {
@@ -57,7 +57,7 @@ namespace eon
 				*static_cast<Node*>( this ) = std::move( other ); return *this; }
 
 		private:
-			inline bool _match( RxData& data, index_t steps ) override {
+			inline bool _match( RxData& data, index_t steps ) const override {
 				return data && !string::isWordChar( data() ) ? data.advance() : false; }
 			inline string _strStruct() const override { return "\\W"; }
 			inline index_t _countMinCharsRemaining() noexcept override {
@@ -1,4 +1,18 @@
 #include "Regression.h"
+#include <cstdlib>
+
+
+// Count heap allocations, for SpeedCmp.allocations
+static std::atomic<size_t> Allocations{ 0 };
+void* operator new( size_t size )
+{
+	++Allocations;
+	if( auto memory = std::malloc( size > 0 ? size : 1 ) )
+		return memory;
+	throw std::bad_alloc();
+}
+void operator delete( void* memory ) noexcept { std::free( memory ); }
+void operator delete( void* memory, size_t ) noexcept { std::free( memory ); }
 
 
 
@@ -313,6 +327,125 @@ namespace eon
 		WANT_FALSE( expr.match( "d" ) ) << "Matched 'd'";
 	}
 
+	TEST( RegExTest, match_chargroup_ranges )
+	{
+		regex expr;
+		REQUIRE_NO_EXCEPT( expr = R"([a-fα-ω0-9€]+$)" ) << "Failed to parse";
+
+		WANT_TRUE( expr.match( "abαω09€" ) ) << "Didn't match ranges";
+		WANT_FALSE( expr.match( "abΩ" ) ) << "Matched outside range";
+		WANT_FALSE( expr.match( "abg" ) ) << "Matched 'g'";
+	}
+	TEST( RegExTest, match_chargroup_icase )
+	{
+		regex expr;
+		REQUIRE_NO_EXCEPT( expr = regex( R"([a-cæ-ø\d]+$)", "i" ) ) << "Failed to parse";
+
+		WANT_TRUE( expr.match( "aBcÆØæ1" ) ) << "Didn't match other case";
+		WANT_FALSE( expr.match( "aBcD" ) ) << "Matched 'D'";
+
+		REQUIRE_NO_EXCEPT( expr = regex( R"([^a-cø]+$)", "i" ) ) << "Failed to parse";
+		WANT_TRUE( expr.match( "xyzå" ) ) << "Didn't match outside negated group";
+		WANT_FALSE( expr.match( "xyzØ" ) ) << "Matched other case in negated group";
+		WANT_FALSE( expr.match( "xyzB" ) ) << "Matched other case in negated group";
+	}
+	TEST( RegExTest, match_chargroup_long_run )
+	{
+		// Runs of ASCII characters are scanned many bytes at a time
+		regex expr{ R"([a-zA-Z0-9_]+)" };
+		string text{ "  Identifier_with_quite_a_long_name_αβγ_and_more_999 rest" };
+		WANT_EQ( "Identifier_with_quite_a_long_name_", string( expr.findFirst( text ).all() ) );
+		WANT_EQ( "_and_more_999", string( expr.findFirst( substring( text.begin() + 37, text.end() ) ).all() ) );
+
+		regex limited{ R"(x[a-z]{2,20}y)" };
+		WANT_TRUE( limited.match( "xabcdefghijklmnopqrsty" ) );
+		WANT_FALSE( limited.match( "xabcdefghijklmnopqrstuy" ) );
+
+		regex negated{ R"([^,]+,)" };
+		WANT_EQ( "a long field with ø and €,", string( negated.findFirst( "a long field with ø and €, next" ).all() ) );
+	}
+
+	TEST( MiscTests, graph_cache )
+	{
+		auto& cache = rx::GraphCache::get();
+		auto hits = cache.hits(), misses = cache.misses();
+		regex first{ R"(cache_test_\d+)" };
+		regex second{ R"(cache_test_\d+)" };
+		regex other{ R"(cache_test_\d+)", "i" };
+		WANT_EQ( hits + 1, cache.hits() );
+		WANT_EQ( misses + 2, cache.misses() );
+		WANT_TRUE( second.match( "cache_test_12" ) );
+		WANT_FALSE( second.match( "CACHE_TEST_12" ) );
+		WANT_TRUE( other.match( "CACHE_TEST_12" ) );
+
+		// Invalid expressions are not cached
+		auto size = cache.size();
+		WANT_EXCEPT( regex( "cache_test", "q" ), rx::InvalidExpression );
+		WANT_EXCEPT( regex( "cache_test", "q" ), rx::InvalidExpression );
+		WANT_EQ( size, cache.size() );
+		WANT_EQ( misses + 4, cache.misses() );
+
+		// Evicted graphs live on in the regex objects using them
+		auto capacity = cache.capacity();
+		cache.capacity( 1 );
+		WANT_EQ( 1, cache.size() );
+		cache.clear();
+		WANT_TRUE( first.match( "cache_test_12" ) );
+		regex third{ R"(cache_test_\d+)" };
+		WANT_EQ( misses + 5, cache.misses() );
+		cache.capacity( capacity );
+	}
+
+	TEST( MiscTests, byteset )
+	{
+		rx::ByteSet chars;
+		for( auto c : string( "abc_" ) )
+			chars.set( static_cast<byte_t>( c ) );
+		std::string text{ "xyzxyzxyzxyzxyzxyzxyzxyzxyz_abcabcabcabcabcabcabcabc!abc" };
+		auto begin = text.c_str(), end = begin + text.size();
+		WANT_EQ( 27, chars.findFirstIn( begin, end ) - begin );
+		WANT_EQ( 52, chars.findFirstNotIn( begin + 27, end ) - begin );
+		WANT_EQ( 53, chars.findFirstIn( begin + 53, begin + 53 ) - begin );
+
+		std::string utf8{ "xyzxyzxyzxyzxyzxyzxyzxyzø" };
+		WANT_EQ( 26, chars.findFirstIn( utf8.c_str(), utf8.c_str() + utf8.size() ) - utf8.c_str() );
+		chars.set( 0xC3 );
+		WANT_EQ( 24, chars.findFirstIn( utf8.c_str(), utf8.c_str() + utf8.size() ) - utf8.c_str() );
+	}
+
+	TEST( MiscTests, stats )
+	{
+		regex expr{ R"(@<key>(\w+)\s*=\s*@<value>(\d+|x))" };
+		WANT_TRUE( expr.findFirst( "a, b, c = 12" ) );
+		WANT_FALSE( expr.match( "a, b" ) );
+		auto copy = expr;
+		WANT_FALSE( copy.findFirst( "no equals here" ) );
+		auto stats = expr.stats();
+		if( !rx::Stats::Enabled )
+		{
+			WANT_EQ( 0, stats.Calls );
+			return;
+		}
+		eon::term << expr.strStats();
+		WANT_EQ( 3, stats.Calls );
+		WANT_EQ( 2, stats.Rejected );
+		WANT_EQ( 4, stats.Skipped );
+		WANT_EQ( 3, stats.Attempts );
+		WANT_TRUE( stats.NodeVisits >= 5 );
+		WANT_EQ( 2, stats.Captures );
+		expr.resetStats();
+		WANT_EQ( 0, copy.stats().Calls );
+
+		// A failing search must give back what the quantifier took
+		regex greedy{ R"(a*b)", "!dp" };
+		WANT_FALSE( greedy.findFirst( string( 12, 'a' ) + "c" ) );
+		auto failed = greedy.stats();
+		WANT_TRUE( failed.Backtracks >= 12 );
+		greedy.resetStats();
+		WANT_TRUE( greedy.findFirst( "ab" ) );
+		WANT_TRUE( greedy.stats().Backtracks < failed.Backtracks );
+	}
+
 	TEST( RegExTest, match_substring )
 	{
 		regex expr;
@@ -724,6 +857,21 @@ namespace eon
 		REQUIRE_TRUE( found ) << "Failed to find alternate";
 		WANT_EQ( "78", eon::string( found.group( name_complete ) ) ) << "Wrong altenate value found";
 	}
+	TEST( FindTests, findFirst_prefilter )
+	{
+		string str{ "name: 12, error:  42, error: x, error:7" };
+		regex prefix{ R"(error:\s*\d+)" };
+		WANT_EQ( "error:  42", string( prefix.findFirst( str ).all() ) );
+		WANT_EQ( 2, prefix.findAll( str ).size() );
+		regex anchored{ R"(^\w+)" };
+		WANT_EQ( "name", string( anchored.findFirst( str ).all() ) );
+		WANT_FALSE( anchored.findFirst( substring( str.begin() + 1, str.end() ) ) ) << "Matched start of input not at start";
+		regex first_chars{ R"(\d+)" };
+		WANT_EQ( "12", string( first_chars.findFirst( str ).all() ) );
+		string utf8{ u8"Ø₠ ₠Ø 17" };
+		WANT_EQ( "17", string( first_chars.findFirst( utf8 ).all() ) );
+		WANT_EQ( 6, first_chars.findFirst( utf8 ).all().begin().numChar() );
+	}
 	TEST( FindTests, findAll )
 	{
 		string good{ "123caa456ba78" };
@@ -846,8 +994,8 @@ namespace eon
 	}	//*/
 	TEST( OptimizeTests, failfast_fixed_end )		// SIGNIFICANT IMPROVEMENT!
 	{
-		regex plain{ R"(.*A$)" };
-		regex optimized( R"(.*A$)", "f" );
+		regex plain{ R"(.*A$)", "!d" };
+		regex optimized( R"(.*A$)", "f!d" );
 		string good{ "ACCCCCCCCCCCCCCCCCCCCCCCCCCCA" };
 		string bad{ "ACCCCCCCCCCCCCCCCCCCCCCCCCCB" };
 		optimizeTest( plain, optimized, good, bad );
@@ -1045,6 +1193,579 @@ namespace eon
 			<< "): " << string::toString( ms.count() ) << "ms\n";
 	}
 
+	TEST( SpeedCmp, log_scan )
+	{
+		// Scan a log for the (few) lines that match, with and without
+		// skipping ahead using literals and first characters
+		string log;
+		for( index_t i = 0; i < 20000; ++i )
+		{
+			log += "2024-01-01 12:00:00 info: request " + string::toString( i ) + " handled in "
+				+ string::toString( i % 97 ) + "ms by worker";
+			if( i % 500 == 0 )
+				log += " error:  " + string::toString( i );
+			log += "\n";
+		}
+		std::chrono::steady_clock clock;
+		for( auto pattern : { R"(error:\s+\d+)", R"(\d{2}ms)" } )
+		{
+			index_t expected = 0;
+			for( auto flags : { "!p", "" } )
+			{
+				regex expr{ pattern, flags };
+				auto start = clock.now();
+				auto found = expr.findAll( log );
+				auto ms = std::chrono::duration_cast<std::chrono::milliseconds>( clock.now() - start );
+				if( *flags )
+					expected = found.size();
+				else
+					WANT_EQ( expected, found.size() ) << pattern;
+				eon::term << pattern << ( *flags ? " without" : " with" ) << " prefilter, "
+					<< string::toString( found.size() ) << " found: " << string::toString( ms.count() ) << "ms\n";
+			}
+		}
+	}
+
+	TEST( SpeedCmp, chargroup_scan )
+	{
+		string text;
+		for( index_t i = 0; i < 20000; ++i )
+			text += "identifier_" + string::toString( i ) + "=SomeValue" + string::toString( i * 7 ) + ", x"
+				+ string::toString( i % 13 ) + "; ";
+		std::chrono::steady_clock clock;
+		for( auto details : std::vector<std::pair<const char*, size_t>>{
+			{ "[a-zA-Z0-9_]+", 60000 }, { "[^,;]+", 40001 }, { "[A-Z][a-z]+", 40000 } } )
+		{
+			regex expr{ details.first };
+			auto start = clock.now();
+			auto found = expr.findAll( text );
+			auto ms = std::chrono::duration_cast<std::chrono::milliseconds>( clock.now() - start );
+			WANT_EQ( details.second, found.size() ) << details.first;
+			eon::term << details.first << ": " << string::toString( found.size() ) << " found: "
+				<< string::toString( ms.count() ) << "ms\n";
+		}
+	}
+
+	TEST( SpeedCmp, construct )
+	{
+		// Constructing the same expressions over and over, with and without
+		// the graph cache
+		std::vector<string> patterns{ R"(\w+\s*=\s*\d+)", R"(@<key>(\l+):@<value>(\d*))", R"([a-zA-Z_][a-zA-Z0-9_]*)",
+			R"((\d+\.)+\d+)", R"(^\s*#.*$)" };
+		auto& cache = rx::GraphCache::get();
+		auto capacity = cache.capacity();
+		std::chrono::steady_clock clock;
+		for( index_t max_graphs : { index_t( 0 ), capacity } )
+		{
+			cache.capacity( max_graphs );
+			auto hits = cache.hits();
+			auto start = clock.now();
+			for( int i = 0; i < 2000; ++i )
+			{
+				for( auto& pattern : patterns )
+					regex expr{ pattern };
+			}
+			auto ms = std::chrono::duration_cast<std::chrono::milliseconds>( clock.now() - start );
+			eon::term << "10000 regex constructions " << ( max_graphs > 0 ? "with" : "without" ) << " cache: "
+				<< string::toString( ms.count() ) << "ms, " << string::toString( cache.hits() - hits ) << " hits\n";
+		}
+		WANT_EQ( capacity, cache.capacity() );
+	}
+
+	TEST( SpeedCmp, allocations )
+	{
+		std::vector<std::pair<regex, string>> cases{
+			{ regex( R"(\w+\s*=\s*\d+)" ), "name = 42" },
+			{ regex( R"(@<key>(\w+)\s*: @<value>(\d{1,3}(\.\d+)?)\s*(alpha|beta){1,2}$)" ), "second   : 7 betaalpha" },
+			{ regex( R"(@<key>(\l+)-@<value>(\l+)-@:<key>)" ), "abc-def-abc" } };
+		size_t rounds = 1000;
+		for( auto& details : cases )
+		{
+			REQUIRE_TRUE( details.first.match( details.second ) ) << details.first.str();
+			size_t before = Allocations;
+			for( size_t i = 0; i < rounds; ++i )
+				details.first.match( details.second );
+			eon::term << details.first.str() << ": " << string::toString(
+				static_cast<double>( Allocations - before ) / rounds ) << " allocations per match\n";
+		}
+		WANT_EQ( "7", string( cases[ 1 ].first.match( cases[ 1 ].second ).group( name_value ) ) );
+		WANT_EQ( "def", string( cases[ 2 ].first.match( cases[ 2 ].second ).group( name_value ) ) );
+	}
+
+	TEST( ThreadTests, shared_regex )
+	{
+		// One regex object, matched from many threads at the same time.
+		// Includes captures, backtracking, and searching, so that all kinds
+		// of match state are exercised.
+		const regex expr{ R"(@<key>(\w+)\s*: @<value>(\d{1,3}(\.\d+)?)\s*(alpha|beta){1,2}$)" };
+		std::vector<std::pair<string, string>> text{
+			{ "first: 12.5 alpha", "12.5" },
+			{ "second   : 7 betaalpha", "7" },
+			{ "third: 123.456 beta", "123.456" },
+			{ "fourth: 1234 alpha", "" },
+			{ "fifth: 9 gamma", "" },
+			{ "sixth: 99.9 alphabetaalpha", "" }
+		};
+		size_t num_threads = std::max( std::thread::hardware_concurrency(), 4u );
+		size_t rounds = 2000;
+#ifdef _DEBUG
+		rounds /= 10;
+#endif
+		std::chrono::steady_clock clock;
+		std::atomic<size_t> failures{ 0 };
+		auto start = clock.now();
+		std::vector<std::thread> threads;
+		for( size_t t = 0; t < num_threads; ++t )
+		{
+			threads.push_back( std::thread( [&expr, &text, &failures, rounds, t]()
+				{
+					for( size_t round = 0; round < rounds; ++round )
+					{
+						// Interleave threads so that they are in different stages of matching
+						for( size_t i = 0; i < text.size(); ++i )
+						{
+							auto& details = text[ ( i + t + round ) % text.size() ];
+							auto match = expr.match( details.first );
+							if( details.second.empty() ? static_cast<bool>( match )
+								: !match || match.group( name_value ) != details.second.substr() )
+								++failures;
+							auto found = expr.findFirst( "-> " + details.first );
+							if( static_cast<bool>( found ) != !details.second.empty() )
+								++failures;
+						}
+					}
+				} ) );
+		}
+		for( auto& thread : threads )
+			thread.join();
+		auto end = clock.now();
+
+		auto ms = std::chrono::duration_cast<std::chrono::milliseconds>( end - start );
+		eon::term << string::toString( num_threads ) << " threads, "
+			<< string::toString( num_threads * rounds * text.size() * 2 ) << " matches/searches: "
+			<< string::toString( ms.count() ) << "ms\n";
+		WANT_EQ( 0, failures.load() );
+	}
+	TEST( ThreadTests, graph_cache )
+	{
+		// Many threads constructing (and matching) the same few expressions,
+		// with a cache too small to hold them all
+		auto& cache = rx::GraphCache::get();
+		auto capacity = cache.capacity();
+		cache.capacity( 2 );
+		size_t num_threads = std::max( std::thread::hardware_concurrency(), 4u );
+		std::atomic<size_t> failures{ 0 };
+		std::vector<std::thread> threads;
+		for( size_t t = 0; t < num_threads; ++t )
+		{
+			threads.push_back( std::thread( [&failures, t]()
+				{
+					for( size_t round = 0; round < 500; ++round )
+					{
+						auto num = string::toString( ( round + t ) % 4 );
+						regex expr{ "thread_" + num + R"(_\d+)" };
+						if( !expr.match( "thread_" + num + "_" + string::toString( round ) ) )
+							++failures;
+					}
+				} ) );
+		}
+		for( auto& thread : threads )
+			thread.join();
+		cache.capacity( capacity );
+		WANT_EQ( 0, failures.load() );
+	}
+
+	TEST( DfaTests, match )
+	{
+		regex expr{ R"(\d+[a-c]+x?)", "d" };
+		auto found = expr.match( "123abcx!" );
+		REQUIRE_TRUE( found ) << "Failed to match";
+		WANT_EQ( "123abcx", string( found.all() ) );
+		WANT_FALSE( expr.match( "abc123" ) ) << "Matched bad";
+		WANT_FALSE( expr.match( "123" ) ) << "Matched incomplete";
+	}
+	TEST( DfaTests, leftmost_longest )
+	{
+		regex backtrack{ R"(a|ab)" };
+		regex dfa{ R"(a|ab)", "d" };
+		WANT_EQ( "a", string( backtrack.match( "abc" ).all() ) );
+		WANT_EQ( "ab", string( dfa.match( "abc" ).all() ) );
+		WANT_EQ( "ab", string( dfa.findFirst( "cab" ).all() ) );
+	}
+	TEST( DfaTests, anchors )
+	{
+		regex expr{ R"(^a\d+$)", "d" };
+		WANT_TRUE( expr.match( "a123" ) );
+		WANT_FALSE( expr.match( "a12x" ) );
+		WANT_FALSE( expr.findFirst( "xa12" ) );
+		regex lines{ R"(b$)", "dl" };
+		WANT_EQ( "b\n", string( lines.findFirst( "ab\ncd" ).all() ) );
+	}
+	TEST( DfaTests, icase )
+	{
+		regex expr{ R"(abc\d)", "di" };
+		WANT_EQ( "AbC1", string( expr.findFirst( "--AbC1--" ).all() ) );
+	}
+	TEST( DfaTests, unsupported )
+	{
+		regex expr;
+		WANT_EXCEPT( expr = regex( R"(@<x>(a)@:<x>)", "d" ), rx::InvalidExpression );
+		WANT_NO_EXCEPT( expr = regex( R"(@<x>(a)@:<x>)" ) );
+		WANT_TRUE( expr.match( "aa" ) );
+	}
+	TEST( DfaTests, same_results )
+	{
+		// The DFA and the literal prefilter only reject non-matches, so
+		// results must be the same with and without them
+		std::vector<const char*> patterns{
+			R"(abc)", R"(^abc)", R"(abc$)", R"(a.c)", R"(a*b)", R"(a+?b)", R"(\d{2,4})", R"((ab|cd)+e)",
+			R"([a-c]+\d)", R"([^a-c]+)", R"(\w+\s*=\s*\d+)", R"(@<key>(\l+):@<value>(\d*))", R"(x(a|b){0,3}y)",
+			R"(\u\l+)", R"(\p+)", R"(^(a|b)*c$)", R"((a*)*b)", R"(.*A$)", R"(\s+$)", R"([abc]+)", R"(ab+c?)",
+			R"(x?abc)", R"(\d+\.\d+)", R"(^\w)", R"(=\s*\d)", R"(@<x>(b)@:<x>)" };
+		std::vector<const char*> texts{
+			"abc", "xabc", "abcx", "aaab", "b", "12345", "ababcde", "cc1", "xyz", "name = 42", "key:12",
+			"xaby", "xababy", "Hello", "!?.", "ababc", "aaaa", "ACCA", "  ", "", u8"Øabc₠", "1.5 and 22.75",
+			u8"₠bb€abbc", "zabcabc" };
+		for( auto pattern : patterns )
+		{
+			regex with_dfa{ pattern };
+			regex without_dfa{ pattern, "!dp" };
+			for( auto text : texts )
+			{
+				WANT_EQ( string( without_dfa.match( text ).all() ), string( with_dfa.match( text ).all() ) )
+					<< "match " << pattern << " \"" << text << "\"";
+				WANT_EQ( string( without_dfa.findFirst( text ).all() ), string( with_dfa.findFirst( text ).all() ) )
+					<< "findFirst " << pattern << " \"" << text << "\"";
+				WANT_EQ( string( without_dfa.findLast( text ).all() ), string( with_dfa.findLast( text ).all() ) )
+					<< "findLast " << pattern << " \"" << text << "\"";
+			}
+		}
+	}
+	TEST( DfaTests, threads )
+	{
+		const regex expr{ R"((\d+\.)+\d+)", "d" };
+		size_t num_threads = std::max( std::thread::hardware_concurrency(), 4u );
+		std::atomic<size_t> failures{ 0 };
+		std::vector<std::thread> threads;
+		for( size_t t = 0; t < num_threads; ++t )
+		{
+			threads.push_back( std::thread( [&expr, &failures]()
+				{
+					for( size_t round = 0; round < 1000; ++round )
+					{
+						if( expr.findFirst( "ip: 10.0.0." + string::toString( round ) + "!" ).all()
+							!= "10.0.0." + string::toString( round ) )
+							++failures;
+					}
+				} ) );
+		}
+		for( auto& thread : threads )
+			thread.join();
+		WANT_EQ( 0, failures.load() );
+	}
+	TEST( DfaTests, pathological )
+	{
+		// Nested quantifiers make the backtracker try a lot of ways of
+		// splitting up the input at each start position before failing. The
+		// DFA does it in a single pass.
+		std::chrono::steady_clock clock;
+		regex backtrack{ R"((a*)*b)", "!dp" };
+		regex prefiltered{ R"((a*)*b)" };
+		regex dfa{ R"((a*)*b)", "d" };
+		for( index_t size : { 100, 400, 1600, 100000 } )
+		{
+			string bad = string( size, 'a' ) + "c";
+			string good = string( size, 'a' ) + "b";
+			if( size <= 1600 )
+			{
+				auto start = clock.now();
+				WANT_FALSE( backtrack.findFirst( bad ) );
+				auto us = std::chrono::duration_cast<std::chrono::microseconds>( clock.now() - start );
+				eon::term << "Backtracking, " << string::toString( size ) << " chars: "
+					<< string::toString( us.count() ) << "us\n";
+			}
+			auto start = clock.now();
+			WANT_FALSE( prefiltered.findFirst( bad ) );
+			auto us = std::chrono::duration_cast<std::chrono::microseconds>( clock.now() - start );
+			eon::term << "Prefiltered, " << string::toString( size ) << " chars: "
+				<< string::toString( us.count() ) << "us\n";
+
+			start = clock.now();
+			WANT_EQ( size + 1, dfa.findFirst( good ).all().numChars() );
+			us = std::chrono::duration_cast<std::chrono::microseconds>( clock.now() - start );
+			eon::term << "DFA, " << string::toString( size ) << " chars: " << string::toString( us.count() ) << "us\n";
+		}
+	}
+
+	TEST( LiteralTests, strategy )
+	{
+		WANT_EQ( "[literal]abc", regex( "abc" ).strStruct().stdstr() );
+		WANT_EQ( "[literal]^abc$", regex( "^abc$" ).strStruct().stdstr() );
+		WANT_EQ( "[literal set]abc|def", regex( "(abc|def)" ).strStruct().stdstr() );
+		WANT_EQ( "abc", regex( "abc", "!l" ).strStruct().stdstr() );
+		WANT_EQ( "abc", regex( "abc", "i" ).strStruct().stdstr() );
+		WANT_EQ( "abc$", regex( "abc$", "l" ).strStruct().stdstr() );
+		WANT_EQ( "abc|de+", regex( "abc|de+" ).strStruct().stdstr() );
+		WANT_EQ( "@<x>(abc)", regex( "@<x>(abc)" ).strStruct().stdstr() );
+	}
+	TEST( LiteralTests, same_results )
+	{
+		// Results must be the same as by the graph
+		std::vector<std::pair<const char*, const char*>> patterns{
+			{ "abc", "" }, { "^abc", "" }, { "abc$", "" }, { "^abc$", "" }, { "abc|ab|b", "" }, { "ab|abc", "" },
+			{ "ab|abc", "d" }, { "^(ab|abc)$", "" }, { "^(ab|abc)$", "d" }, { "(c|bc|abc)$", "" },
+			{ "(c|bc|abc)$", "d" }, { u8"€|ø", "" }, { u8"ø€", "" }, { "abc", "d" } };
+		std::vector<const char*> texts{
+			"abc", "xabc", "abcx", "ab", "aab", "babc", "abcabc", "b", "xyz", u8"ø€abc", u8"x€ø€" };
+		for( auto& pattern : patterns )
+		{
+			regex literal{ pattern.first, pattern.second };
+			regex graph{ pattern.first, string( pattern.second ) + "!l" };
+			REQUIRE_TRUE( literal.strStruct().startsWith( "[literal" ) ) << pattern.first;
+			for( auto text : texts )
+			{
+				string str{ text };
+				auto expected = graph.match( str ), actual = literal.match( str );
+				WANT_EQ( string( expected.all() ), string( actual.all() ) ) << "match " << pattern.first << " \"" << text << "\"";
+				expected = graph.findFirst( str );
+				actual = literal.findFirst( str );
+				WANT_EQ( string( expected.all() ), string( actual.all() ) )
+					<< "findFirst " << pattern.first << " \"" << text << "\"";
+				if( expected && actual )
+					WANT_EQ( expected.all().begin().numChar(), actual.all().begin().numChar() )
+						<< "findFirst " << pattern.first << " \"" << text << "\"";
+				WANT_EQ( graph.findAll( str ).size(), literal.findAll( str ).size() )
+					<< "findAll " << pattern.first << " \"" << text << "\"";
+			}
+		}
+	}
+	TEST( LiteralTests, speed )
+	{
+		string text;
+		for( index_t i = 0; i < 20000; ++i )
+			text += "2024-01-01 12:00:00 info: request " + string::toString( i ) + ( i % 500 == 0 ? " failed" : " done" )
+				+ ( i % 1000 == 0 ? " timeout\n" : "\n" );
+		std::chrono::steady_clock clock;
+		for( auto pattern : { "failed", "timeout|refused|reset", "^2024-01-01" } )
+		{
+			size_t expected = 0;
+			for( auto flags : { "!l", "" } )
+			{
+				regex expr{ pattern, flags };
+				auto start = clock.now();
+				auto found = expr.findAll( text );
+				auto us = std::chrono::duration_cast<std::chrono::microseconds>( clock.now() - start );
+				if( *flags )
+					expected = found.size();
+				else
+					WANT_EQ( expected, found.size() ) << pattern;
+				eon::term << pattern << ( *flags ? " by graph, " : " by literal matcher, " )
+					<< string::toString( found.size() ) << " found: " << string::toString( us.count() ) << "us\n";
+			}
+		}
+	}
+
+
+	std::vector<std::pair<size_t, string>> ScannerTests::scan(
+		const regex& expr, const std::string& text, size_t chunk_size, size_t max_match )
+	{
+		std::vector<std::pair<size_t, string>> found;
+		regex::scanner scanner( expr, [&found]( size_t offset, const rx::match& match ) {
+			found.push_back( std::make_pair( offset, string( match.all() ) ) ); return true; }, max_match );
+		for( size_t pos = 0; pos < text.size(); pos += chunk_size )
+			scanner.feed( text.c_str() + pos, std::min( chunk_size, text.size() - pos ) );
+		scanner.finish();
+		return found;
+	}
+	std::vector<std::pair<size_t, string>> ScannerTests::findAll( const regex& expr, const std::string& text )
+	{
+		std::vector<std::pair<size_t, string>> found;
+		string str{ text };
+		for( auto& match : expr.findAll( str ) )
+			found.push_back( std::make_pair( match.all().begin().byteData() - str.c_str(), string( match.all() ) ) );
+		return found;
+	}
+
+	TEST( ScannerTests, same_as_findAll )
+	{
+		std::string text{ u8"key1 = 12, other_key=7; ørsted=€99 x = 1234567 end=0 and some more words 88 to end" };
+		for( auto pattern : { R"(\w+\s*=\s*\d+)", R"(\d+)", R"([a-z]+)", R"(\bo\w+)", R"(=€?\d)" } )
+		{
+			regex expr{ pattern };
+			auto expected = findAll( expr, text );
+			REQUIRE_FALSE( expected.empty() ) << pattern;
+			for( size_t chunk_size : { 1, 2, 3, 5, 16, 1000 } )
+			{
+				auto actual = scan( expr, text, chunk_size, 16 );
+				REQUIRE_EQ( expected.size(), actual.size() ) << pattern << ", chunk size " << chunk_size;
+				for( size_t i = 0; i < expected.size(); ++i )
+				{
+					WANT_EQ( expected[ i ].first, actual[ i ].first ) << pattern << ", chunk size " << chunk_size;
+					WANT_EQ( expected[ i ].second, actual[ i ].second ) << pattern << ", chunk size " << chunk_size;
+				}
+			}
+		}
+	}
+	TEST( ScannerTests, anchored_start )
+	{
+		regex expr{ "^ab" };
+		auto found = scan( expr, "abcab abab", 1, 4 );
+		REQUIRE_EQ( 1, found.size() );
+		WANT_EQ( 0, found[ 0 ].first );
+		WANT_TRUE( scan( expr, "xabcab abab", 3, 4 ).empty() );
+	}
+	TEST( ScannerTests, stop )
+	{
+		regex expr{ R"(\d+)" };
+		size_t calls = 0;
+		regex::scanner scanner( expr, [&calls]( size_t, const rx::match& ) { return ++calls < 2; }, 8 );
+		scanner.feed( "1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16" );
+		scanner.finish();
+		WANT_TRUE( scanner.stopped() );
+		WANT_EQ( 2, calls );
+	}
+	TEST( ScannerTests, source )
+	{
+		regex expr{ R"(\d+)" };
+		source::String src( "test", "line 1\nline 22\nline 333\n" );
+		std::vector<string> found;
+		regex::scanner scanner( expr, [&found]( size_t, const rx::match& match ) {
+			found.push_back( string( match.all() ) ); return true; }, 4 );
+		scanner.scan( src, 5 );
+		WANT_TRUE( scanner.finished() );
+		WANT_EQ( 24, scanner.numBytes() );
+		REQUIRE_EQ( 3, found.size() );
+		WANT_EQ( "333", found[ 2 ] );
+	}
+	TEST( ScannerTests, reader )
+	{
+		regex expr{ R"(error: \d+)" };
+		std::string line{ "info: all is well\n" }, error_line{ "error: 42\n" };
+		size_t lines = 0, matches = 0, last_offset = 0;
+		regex::scanner scanner( expr, [&]( size_t offset, const rx::match& ) {
+			++matches; last_offset = offset; return true; } );
+		std::chrono::steady_clock clock;
+		auto start = clock.now();
+		scanner.scan( [&]( char* buffer, size_t size ) -> size_t {
+			// Generate about 20 MB of log, without holding it in memory
+			size_t num = 0;
+			while( lines < 1000000 && size - num >= error_line.size() + line.size() )
+			{
+				auto& next = lines % 1000 == 999 ? error_line : line;
+				memcpy( buffer + num, next.c_str(), next.size() );
+				num += next.size();
+				++lines;
+			}
+			return num; } );
+		auto ms = std::chrono::duration_cast<std::chrono::milliseconds>( clock.now() - start );
+		WANT_EQ( 1000, matches );
+		WANT_EQ( scanner.numBytes() - error_line.size(), last_offset );
+		eon::term << "Scanned " << string::toString( scanner.numBytes() / 1000000 ) << " MB in "
+			<< string::toString( ms.count() ) << "ms\n";
+	}
+
+	string RegexSetTests::str( const std::vector<index_t>& numbers )
+	{
+		string result;
+		for( auto number : numbers )
+			result += ( result.empty() ? "" : "," ) + string::toString( number );
+		return result;
+	}
+
+	TEST( RegexSetTests, same_as_findFirst )
+	{
+		// Combined or not (backreferences, word boundaries, '!d'), results
+		// must be the same as searching with each expression
+		std::vector<std::pair<const char*, const char*>> patterns{
+			{ R"(abc)", "" }, { R"(^abc)", "" }, { R"(abc$)", "" }, { R"(\d{2,4})", "" }, { R"((ab|cd)+e)", "" },
+			{ R"([^a-c]+)", "" }, { R"(\w+\s*=\s*\d+)", "" }, { R"(@<x>(b)@:<x>)", "" }, { R"(\bxy)", "" },
+			{ R"(ABC)", "i" }, { R"(a+b)", "d" }, { R"(\d+\.\d+)", "!d" }, { R"(\s+$)", "" }, { R"(€\d)", "" } };
+		std::vector<const char*> texts{
+			"abc", "xabc", "abcx", "aaab", "b", "12345", "ababcde", "xyz", "name = 42", "bb", "ABC", "aBc",
+			"1.5 and 22.75", "  ", "", u8"Øabc€1", "xy abbc" };
+		rx::regex_set set;
+		std::vector<regex> expressions;
+		for( auto& pattern : patterns )
+		{
+			expressions.push_back( regex( pattern.first, pattern.second ) );
+			WANT_EQ( expressions.size() - 1, set.add( expressions.back() ) );
+		}
+		REQUIRE_EQ( patterns.size(), set.size() );
+		WANT_EQ( patterns.size() - 3, set.numCombined() );
+		for( auto text : texts )
+		{
+			std::vector<index_t> expected_matches;
+			std::vector<string> expected_found;
+			for( index_t i = 0; i < expressions.size(); ++i )
+			{
+				auto found = expressions[ i ].findFirst( text );
+				if( found )
+				{
+					expected_matches.push_back( i );
+					expected_found.push_back( string( found.all() ) );
+				}
+			}
+			auto matches = set.matches( text );
+			WANT_EQ( str( expected_matches ), str( matches ) ) << "\"" << text << "\"";
+			auto found = set.findFirst( text );
+			REQUIRE_EQ( expected_found.size(), found.size() ) << "\"" << text << "\"";
+			for( index_t i = 0; i < found.size(); ++i )
+			{
+				WANT_EQ( expected_matches[ i ], found[ i ].first ) << "\"" << text << "\"";
+				WANT_EQ( expected_found[ i ], string( found[ i ].second.all() ) ) << "\"" << text << "\"";
+			}
+		}
+	}
+	TEST( RegexSetTests, copy )
+	{
+		rx::regex_set set{ regex( R"(\d+)" ), regex( "[a-z]+" ), regex( R"(@<x>(a)@:<x>)" ) };
+		auto copy = set;
+		set.clear();
+		WANT_TRUE( set.matches( "abc 12" ).empty() );
+		WANT_EQ( 2, copy.numCombined() );
+		WANT_EQ( "0,1", str( copy.matches( "abc 12" ) ) );
+		WANT_EQ( "1,2", str( copy.matches( "xaa" ) ) );
+	}
+	TEST( RegexSetTests, route )
+	{
+		// Route log lines to one of 100 expressions, one expression at a
+		// time and using a set
+		std::vector<regex> expressions;
+		rx::regex_set set;
+		for( index_t i = 0; i < 100; ++i )
+		{
+			expressions.push_back( regex( "service" + string::toString( i ) + R"(: (error|warning) \d+ in \w+)" ) );
+			set.add( expressions.back() );
+		}
+		std::vector<string> lines;
+		for( index_t i = 0; i < 20000; ++i )
+			lines.push_back( "2024-01-01 12:00:00 service" + string::toString( ( i * 7 ) % 100 ) + ": "
+				+ ( i % 3 == 0 ? "error " : "info " ) + string::toString( i ) + " in handler_"
+				+ string::toString( i % 11 ) );
+
+		std::chrono::steady_clock clock;
+		size_t one_by_one = 0, combined = 0;
+		auto start = clock.now();
+		for( auto& line : lines )
+		{
+			for( auto& expression : expressions )
+			{
+				if( expression.findFirst( line ) )
+					++one_by_one;
+			}
+		}
+		auto ms_one_by_one = std::chrono::duration_cast<std::chrono::milliseconds>( clock.now() - start );
+		start = clock.now();
+		for( auto& line : lines )
+			combined += set.matches( line ).size();
+		auto ms_combined = std::chrono::duration_cast<std::chrono::milliseconds>( clock.now() - start );
+		WANT_EQ( 6667, one_by_one );
+		WANT_EQ( one_by_one, combined );
+		eon::term << "100 expressions x " << string::toString( lines.size() ) << " lines, one by one: "
+			<< string::toString( ms_one_by_one.count() ) << "ms, as set: " << string::toString( ms_combined.count() )
+			<< "ms\n";
+	}
+
 	/* The "bad" tests will always fail so only use for testing of WANT_MATCH/REQUIRE_MATCH!
 	TEST( TestRegex, lines_good )
 	{
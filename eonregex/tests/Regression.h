@@ -2,6 +2,12 @@
 
 #include <eontest/Test.h>
 #include <eonregex/RegEx.h>
+#include <eonregex/Scanner.h>
+#include <eonregex/RegexSet.h>
+#include <eonsource/String.h>
+#include <thread>
+#include <atomic>
+#include <chrono>
 
 
 namespace eon
@@ -17,4 +23,23 @@ namespace eon
 	};
 	class SpeedCmp : public eontest::EonTest {};
 	class TestRegex : public eontest::EonTest {};
+	class ThreadTests : public eontest::EonTest {};
+	class DfaTests : public eontest::EonTest {};
+	class LiteralTests : public eontest::EonTest {};
+	class ScannerTests : public eontest::EonTest
+	{
+	public:
+		// Scan 'text' fed in chunks of 'chunk_size' bytes, get match offsets and values
+		std::vector<std::pair<size_t, string>> scan(
+			const regex& expr, const std::string& text, size_t chunk_size, size_t max_match );
+
+		// Get match offsets and values using findAll
+		std::vector<std::pair<size_t, string>> findAll( const regex& expr, const std::string& text );
+	};
+	class RegexSetTests : public eontest::EonTest
+	{
+	public:
+		// Get expression numbers as a comma separated string
+		string str( const std::vector<index_t>& numbers );
+	};
 }
@@ -0,0 +1,405 @@
+#include "MappedFile.h"
+#ifdef EON_WINDOWS
+#	include <windows.h>
+#else
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+
+namespace eon
+{
+	namespace source
+	{
+		MappedFile::MappedFile( const string& name )
+		{
+			if( name.empty() )
+				throw BadName();
+			Name = name;
+			_map();
+		}
+		EON_TEST_3STEP_SANDBOX( MappedFile, MappedFile, name,
+			saveFile( "source.txt", "one two three" ),
+			MappedFile obj( ( sandboxDir() / "source.txt" ).string() ),
+			EON_EQ( ( sandboxDir() / "source.txt" ).string(), obj.sourceName() ) );
+		EON_TEST( MappedFile, MappedFile, no_file,
+			EON_RAISE( MappedFile( "/nonexisting/source.txt" ), BadName ) );
+
+
+
+
+		EON_TEST_2STEP_SANDBOX( MappedFile, numBytesInSource, empty,
+			saveFile( "source.txt", "" ),
+			EON_EQ( 0, MappedFile( ( sandboxDir() / "source.txt" ).string() ).numBytesInSource() ) );
+		EON_TEST_2STEP_SANDBOX( MappedFile, numBytesInSource, non_empty,
+			saveFile( "source.txt", "one two three" ),
+			EON_EQ( 13, MappedFile( ( sandboxDir() / "source.txt" ).string() ).numBytesInSource() ) );
+
+
+
+
+		Pos MappedFile::getPosAtOffset( Pos base_position, int offset_chars )
+		{
+			if( offset_chars < 0 )
+				_backward( base_position, -offset_chars );
+			else if( offset_chars > 0 )
+				_forward( base_position, offset_chars );
+			return base_position;
+		}
+		EON_TEST_3STEP_SANDBOX( MappedFile, getPosAtOffset, zero,
+			saveFile( "source.txt", "one two three" ),
+			Pos base( 5, 5, 0, 5 ),
+			EON_EQ( base, MappedFile( ( sandboxDir() / "source.txt" ).string() ).getPosAtOffset( base, 0 ) ) );
+		EON_TEST_3STEP_SANDBOX( MappedFile, getPosAtOffset, positive_one,
+			saveFile( "source.txt", "one two three" ),
+			Pos base( 5, 5, 0, 5 ),
+			EON_EQ( Pos( 6, 6, 0, 6 ), MappedFile( ( sandboxDir() / "source.txt" ).string() ).getPosAtOffset( base, 1 ) ) );
+		EON_TEST_3STEP_SANDBOX( MappedFile, getPosAtOffset, negative_one,
+			saveFile( "source.txt", "one two three" ),
+			Pos base( 5, 5, 0, 5 ),
+			EON_EQ( Pos( 4, 4, 0, 4 ), MappedFile( ( sandboxDir() / "source.txt" ).string() ).getPosAtOffset( base, -1 ) ) );
+		EON_TEST_3STEP_SANDBOX( MappedFile, getPosAtOffset, positive_cross_line,
+			saveFile( "source.txt", "one\ntwo\nthree" ),
+			Pos base( 5, 5, 1, 1 ),
+			EON_EQ( Pos( 9, 9, 2, 1 ).rawStr(),
+				MappedFile( ( sandboxDir() / "source.txt" ).string() ).getPosAtOffset( base, 4 ).rawStr() ) );
+		EON_TEST_3STEP_SANDBOX( MappedFile, getPosAtOffset, negative_cross_line,
+			saveFile( "source.txt", "one\ntwo\nthree" ),
+			Pos base( 5, 5, 1, 1 ),
+			EON_EQ( Pos( 1, 1, 0, 1 ), MappedFile( ( sandboxDir() / "source.txt" ).string() ).getPosAtOffset( base, -4 ) ) );
+		EON_TEST_3STEP_SANDBOX( MappedFile, getPosAtOffset, utf8,
+			saveFile( "source.txt", u8"Ø₠œ" ),
+			Pos base( 0, 0, 0, 0 ),
+			EON_EQ( Pos( 5, 2, 0, 2 ).rawStr(),
+				MappedFile( ( sandboxDir() / "source.txt" ).string() ).getPosAtOffset( base, 2 ).rawStr() ) );
+
+		bool MappedFile::match( const Pos& start, const Pos& end, const eon::string& value ) const noexcept
+		{
+			Pos last = end;
+			if( !_area( start, last ) )
+				return value.empty();
+			return last.BytePos - start.BytePos == value.numBytes()
+				&& memcmp( Data + start.BytePos, value.c_str(), value.numBytes() ) == 0;
+		}
+		EON_TEST_3STEP_SANDBOX( MappedFile, match, str_positive,
+			saveFile( "source.txt", "one two three" ),
+			string value = "two",
+			EON_TRUE( MappedFile( ( sandboxDir() / "source.txt" ).string() ).match(
+				Pos( 4, 4, 0, 4 ), Pos( 7, 7, 0, 7 ), value ) ) );
+		EON_TEST_3STEP_SANDBOX( MappedFile, match, str_negative,
+			saveFile( "source.txt", "one two three" ),
+			string value = "two",
+			EON_FALSE( MappedFile( ( sandboxDir() / "source.txt" ).string() ).match(
+				Pos( 5, 5, 0, 5 ), Pos( 8, 8, 0, 8 ), value ) ) );
+
+		bool MappedFile::match( const Pos& start, const Pos& end, const char* value ) const noexcept
+		{
+			Pos last = end;
+			auto size = strlen( value );
+			if( !_area( start, last ) )
+				return size == 0;
+			return last.BytePos - start.BytePos == size && memcmp( Data + start.BytePos, value, size ) == 0;
+		}
+		EON_TEST_2STEP_SANDBOX( MappedFile, match, cstr_positive,
+			saveFile( "source.txt", "one two three" ),
+			EON_TRUE( MappedFile( ( sandboxDir() / "source.txt" ).string() ).match(
+				Pos( 4, 4, 0, 4 ), Pos( 7, 7, 0, 7 ), "two" ) ) );
+		EON_TEST_2STEP_SANDBOX( MappedFile, match, cstr_negative,
+			saveFile( "source.txt", "one two three" ),
+			EON_FALSE( MappedFile( ( sandboxDir() / "source.txt" ).string() ).match(
+				Pos( 5, 5, 0, 5 ), Pos( 8, 8, 0, 8 ), "two" ) ) );
+
+		char_t MappedFile::chr( const Pos& pos ) noexcept
+		{
+			if( pos.BytePos >= NumBytes )
+				return nochar;
+			auto c = static_cast<byte_t>( Data[ pos.BytePos ] );
+			if( c < 0x80 )
+				return c;
+			char_t cp{ 0 };
+			if( string_iterator::bytesToUnicode( Data + pos.BytePos, Data + NumBytes, cp ) == 0 )
+				return nochar;
+			return cp;
+		}
+		EON_TEST_2STEP_SANDBOX( MappedFile, chr, first,
+			saveFile( "source.txt", "123456789" ),
+			EON_EQ( '1', MappedFile( ( sandboxDir() / "source.txt" ).string() ).chr( Pos( 0, 0, 0, 0 ) ) ) );
+		EON_TEST_2STEP_SANDBOX( MappedFile, chr, last,
+			saveFile( "source.txt", "123456789" ),
+			EON_EQ( '9', MappedFile( ( sandboxDir() / "source.txt" ).string() ).chr( Pos( 8, 8, 0, 8 ) ) ) );
+		EON_TEST_2STEP_SANDBOX( MappedFile, chr, beyond_last,
+			saveFile( "source.txt", "123456789" ),
+			EON_EQ( nochar, MappedFile( ( sandboxDir() / "source.txt" ).string() ).chr( Pos( 9, 9, 0, 9 ) ) ) );
+		EON_TEST_2STEP_SANDBOX( MappedFile, chr, utf8,
+			saveFile( "source.txt", u8"Ø₠œ" ),
+			EON_EQ( char_t( 0x20A0 ), MappedFile( ( sandboxDir() / "source.txt" ).string() ).chr( Pos( 2, 1, 0, 1 ) ) ) );
+
+		EON_TEST_2STEP_SANDBOX( MappedFile, byte, first,
+			saveFile( "source.txt", "123456789" ),
+			EON_EQ( '1', MappedFile( ( sandboxDir() / "source.txt" ).string() ).byte( 0 ) ) );
+		EON_TEST_2STEP_SANDBOX( MappedFile, byte, beyond_last,
+			saveFile( "source.txt", "123456789" ),
+			EON_EQ( -1, MappedFile( ( sandboxDir() / "source.txt" ).string() ).byte( 9 ) ) );
+
+		string MappedFile::str( Pos start, Pos end ) noexcept
+		{
+			if( !_area( start, end ) )
+				return string();
+			return string( view( start, end ) );
+		}
+		EON_TEST_2STEP_SANDBOX( MappedFile, str, empty,
+			saveFile( "source.txt", "" ),
+			EON_EQ( "", MappedFile( ( sandboxDir() / "source.txt" ).string() ).str( Pos( 0, 0, 0, 0 ), Pos( 9, 9, 0, 9 ) ) ) );
+		EON_TEST_2STEP_SANDBOX( MappedFile, str, non_empty,
+			saveFile( "source.txt", "one two three" ),
+			EON_EQ( "two", MappedFile( ( sandboxDir() / "source.txt" ).string() ).str(
+				Pos( 4, 4, 0, 4 ), Pos( 7, 7, 0, 7 ) ) ) );
+		EON_TEST_2STEP_SANDBOX( MappedFile, str, to_end,
+			saveFile( "source.txt", "one two three" ),
+			EON_EQ( "three", MappedFile( ( sandboxDir() / "source.txt" ).string() ).str(
+				Pos( 8, 8, 0, 8 ), Pos() ) ) );
+
+		std::string MappedFile::bytes( Pos start, Pos end ) noexcept
+		{
+			if( !_area( start, end ) )
+				return std::string();
+			return std::string( Data + start.BytePos, end.BytePos - start.BytePos );
+		}
+		EON_TEST_2STEP_SANDBOX( MappedFile, bytes, empty,
+			saveFile( "source.txt", "" ),
+			EON_EQ( "", MappedFile( ( sandboxDir() / "source.txt" ).string() ).bytes(
+				Pos( 0, 0, 0, 0 ), Pos( 9, 9, 0, 9 ) ) ) );
+		EON_TEST_2STEP_SANDBOX( MappedFile, bytes, non_empty,
+			saveFile( "source.txt", "one two three" ),
+			EON_EQ( "two", MappedFile( ( sandboxDir() / "source.txt" ).string() ).bytes(
+				Pos( 4, 4, 0, 4 ), Pos( 7, 7, 0, 7 ) ) ) );
+
+		substring MappedFile::view( Pos start, Pos end ) const noexcept
+		{
+			if( !_area( start, end ) )
+				return substring();
+			string_iterator beg( Data + start.BytePos, end.BytePos - start.BytePos );
+			return substring( beg, beg.getEnd() );
+		}
+		EON_TEST_3STEP_SANDBOX( MappedFile, view, non_empty,
+			saveFile( "source.txt", "one two three" ),
+			MappedFile obj( ( sandboxDir() / "source.txt" ).string() ),
+			EON_EQ( "two", string( obj.view( Pos( 4, 4, 0, 4 ), Pos( 7, 7, 0, 7 ) ) ) ) );
+
+
+
+
+		void MappedFile::_map()
+		{
+#ifdef EON_WINDOWS
+			FileHandle = CreateFileW( Name.stdwstr().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+				FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+			if( FileHandle == INVALID_HANDLE_VALUE )
+			{
+				FileHandle = nullptr;
+				throw BadName();
+			}
+			LARGE_INTEGER size;
+			if( GetFileType( FileHandle ) != FILE_TYPE_DISK || !GetFileSizeEx( FileHandle, &size ) )
+			{
+				_unmap();
+				throw NotMappable( Name );
+			}
+			NumBytes = static_cast<size_t>( size.QuadPart );
+			if( NumBytes == 0 )
+				return;
+			MapHandle = CreateFileMappingW( FileHandle, NULL, PAGE_READONLY, 0, 0, NULL );
+			if( MapHandle != nullptr )
+				Data = static_cast<const char*>( MapViewOfFile( MapHandle, FILE_MAP_READ, 0, 0, 0 ) );
+			if( Data == nullptr )
+			{
+				_unmap();
+				throw NotMappable( Name );
+			}
+#else
+			auto handle = ::open( Name.c_str(), O_RDONLY );
+			if( handle < 0 )
+				throw BadName();
+			struct stat info;
+			if( ::fstat( handle, &info ) != 0 || !S_ISREG( info.st_mode ) )
+			{
+				::close( handle );
+				throw NotMappable( Name );
+			}
+			NumBytes = static_cast<size_t>( info.st_size );
+			if( NumBytes == 0 )
+			{
+				::close( handle );
+				return;
+			}
+			auto data = ::mmap( nullptr, NumBytes, PROT_READ, MAP_PRIVATE, handle, 0 );
+			::close( handle );
+			if( data == MAP_FAILED )
+			{
+				NumBytes = 0;
+				throw NotMappable( Name );
+			}
+			::madvise( data, NumBytes, MADV_SEQUENTIAL );
+			Data = static_cast<const char*>( data );
+#endif
+		}
+		EON_NO_TEST( MappedFile, _map );
+
+		void MappedFile::_unmap() noexcept
+		{
+#ifdef EON_WINDOWS
+			if( Data != nullptr )
+				UnmapViewOfFile( Data );
+			if( MapHandle != nullptr )
+				CloseHandle( MapHandle );
+			if( FileHandle != nullptr )
+				CloseHandle( FileHandle );
+			MapHandle = nullptr;
+			FileHandle = nullptr;
+#else
+			if( Data != nullptr )
+				::munmap( const_cast<char*>( Data ), NumBytes );
+#endif
+			Data = nullptr;
+			NumBytes = 0;
+		}
+		EON_NO_TEST( MappedFile, _unmap );
+
+		bool MappedFile::_area( const Pos& start, Pos& end ) const noexcept
+		{
+			if( end.BytePos == 0 || end.BytePos > NumBytes )
+				end.BytePos = NumBytes;
+			return start.BytePos < NumBytes && start < end;
+		}
+		EON_NO_TEST( MappedFile, _area );
+
+		void MappedFile::_forward( Pos& pos, index_t num_chars )
+		{
+			if( num_chars == 0 )
+				return;
+			if( pos.BytePos >= NumBytes )
+				throw EndOfSource();
+			while( pos.BytePos < NumBytes && num_chars > 0 )
+			{
+				char_t cp = static_cast<byte_t>( Data[ pos.BytePos ] );
+				index_t num = 1;
+				if( cp >= 0x80 )
+				{
+					num = string_iterator::bytesToUnicode( Data + pos.BytePos, Data + NumBytes, cp );
+					if( num == 0 )
+						throw InvalidUTF8( "Not a valid UTF-8 file" );
+				}
+				if( cp == NewlineChr )
+				{
+					if( pos.Line == NumCharsOnLines.size() )
+						NumCharsOnLines.push_back( pos.PosOnLine );
+					++pos.Line;
+					pos.PosOnLine = 0;
+					--num_chars;
+				}
+				else if( cp != CReturnChr )
+				{
+					++pos.PosOnLine;
+					--num_chars;
+				}
+				++pos.CharPos;
+				pos.BytePos += num;
+			}
+		}
+		EON_TEST_4STEP_SANDBOX( MappedFile, _forward, legal,
+			saveFile( "source.txt", "one" ),
+			Pos pos( 0, 0, 0, 0 ),
+			MappedFile( ( sandboxDir() / "source.txt" ).string() )._forward( pos, 1 ),
+			EON_EQ( 1, pos.BytePos ) );
+		EON_TEST_4STEP_SANDBOX( MappedFile, _forward, legal_past_newline,
+			saveFile( "source.txt", "one\ntwo" ),
+			Pos pos( 0, 0, 0, 0 ),
+			MappedFile( ( sandboxDir() / "source.txt" ).string() )._forward( pos, 4 ),
+			EON_EQ( Pos( 4, 4, 1, 0 ), pos ) );
+		EON_TEST_4STEP_SANDBOX( MappedFile, _forward, beyond_last,
+			saveFile( "source.txt", "one" ),
+			Pos pos( 0, 0, 0, 0 ),
+			MappedFile( ( sandboxDir() / "source.txt" ).string() )._forward( pos, 10 ),
+			EON_EQ( 3, pos.BytePos ) );
+		EON_TEST_3STEP_SANDBOX( MappedFile, _forward, end_of_source,
+			saveFile( "source.txt", "one" ),
+			Pos pos( 4, 4, 0, 4 ),
+			EON_RAISE( MappedFile( ( sandboxDir() / "source.txt" ).string() )._forward( pos, 1 ), EndOfSource ) );
+
+		void MappedFile::_backward( Pos& pos, index_t num_chars )
+		{
+			if( pos.BytePos > NumBytes )
+				throw EndOfSource();
+			for( ; pos.BytePos > 0 && num_chars > 0; --num_chars )
+			{
+				auto end = Data + pos.BytePos;
+				auto beg = end - 1;
+				for( int i = 1; i < 4 && beg > Data && ( static_cast<byte_t>( *beg ) & 0xC0 ) == 0x80; ++i )
+					--beg;
+				char_t cp{ 0 };
+				string_iterator::bytesToUnicode( beg, end, cp );
+				if( cp == NewlineChr )
+				{
+					--pos.Line;
+					if( NumCharsOnLines.empty() )
+						_scanFile();
+					pos.PosOnLine = NumCharsOnLines[ pos.Line ];
+				}
+				else
+					--pos.PosOnLine;
+				--pos.CharPos;
+				pos.BytePos -= ( end - beg );
+			}
+		}
+		EON_TEST_4STEP_SANDBOX( MappedFile, _backward, legal,
+			saveFile( "source.txt", "one" ),
+			Pos pos( 3, 3, 0, 3 ),
+			MappedFile( ( sandboxDir() / "source.txt" ).string() )._backward( pos, 1 ),
+			EON_EQ( 2, pos.BytePos ) );
+		EON_TEST_4STEP_SANDBOX( MappedFile, _backward, legal_past_newline,
+			saveFile( "source.txt", "one\ntwo" ),
+			Pos pos( 7, 7, 1, 7 ),
+			MappedFile( ( sandboxDir() / "source.txt" ).string() )._backward( pos, 4 ),
+			EON_EQ( Pos( 3, 3, 0, 3 ), pos ) );
+		EON_TEST_4STEP_SANDBOX( MappedFile, _backward, beyond_first,
+			saveFile( "source.txt", "one" ),
+			Pos pos( 3, 3, 0, 3 ),
+			MappedFile( ( sandboxDir() / "source.txt" ).string() )._backward( pos, 10 ),
+			EON_EQ( 0, pos.BytePos ) );
+		EON_TEST_4STEP_SANDBOX( MappedFile, _backward, utf8,
+			saveFile( "source.txt", u8"Ø₠œ" ),
+			Pos pos( 7, 3, 0, 3 ),
+			MappedFile( ( sandboxDir() / "source.txt" ).string() )._backward( pos, 2 ),
+			EON_EQ( Pos( 2, 1, 0, 1 ).rawStr(), pos.rawStr() ) );
+		EON_TEST_3STEP_SANDBOX( MappedFile, _backward, end_of_source,
+			saveFile( "source.txt", "one" ),
+			Pos pos( 10, 10, 0, 10 ),
+			EON_RAISE( MappedFile( ( sandboxDir() / "source.txt" ).string() )._backward( pos, 2 ), EndOfSource ) );
+
+		void MappedFile::_scanFile()
+		{
+			NumCharsOnLines.clear();
+			Pos pos( 0, 0, 0, 0 );
+			if( NumBytes > 0 )
+				_forward( pos, NumBytes );
+			NumCharsOnLines.push_back( pos.PosOnLine );
+		}
+		EON_TEST_4STEP_SANDBOX( MappedFile, _scanFile, empty,
+			saveFile( "source.txt", "" ),
+			MappedFile obj( ( sandboxDir() / "source.txt" ).string() ),
+			obj._scanFile(),
+			EON_EQ( 1, obj.NumCharsOnLines.size() ) );
+		EON_TEST_4STEP_SANDBOX( MappedFile, _scanFile, multiple,
+			saveFile( "source.txt", "one\ntwo\nthree" ),
+			MappedFile obj( ( sandboxDir() / "source.txt" ).string() ),
+			obj._scanFile(),
+			EON_EQ( 3, obj.NumCharsOnLines.size() ) );
+		EON_TEST_4STEP_SANDBOX( MappedFile, _scanFile, multiple_line_length,
+			saveFile( "source.txt", "one\ntwo\nthree" ),
+			MappedFile obj( ( sandboxDir() / "source.txt" ).string() ),
+			obj._scanFile(),
+			EON_EQ( 5, obj.NumCharsOnLines[ 2 ] ) );
+	}
+}
\ No newline at end of file
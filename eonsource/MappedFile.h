@@ -0,0 +1,146 @@
+#pragma once
+#include "Raw.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// The 'eon' namespace encloses all public functionality
+//
+namespace eon
+{
+	///////////////////////////////////////////////////////////////////////////
+	//
+	// The 'source' namespace encloses all source functionality
+	//
+	namespace source
+	{
+		// Exception used when attempting to memory map a file that cannot be
+		// mapped (such as a pipe or a device).
+		EONEXCEPT( NotMappable );
+
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Eon Memory Mapped File Source Class - eon::source::MappedFile
+		//
+		// A subclass of [eon::source::Raw], using a memory mapped file as
+		// source. Characters and substrings are served directly from the
+		// mapped pages, no seeking or copying is involved.
+		// Use [eon::source::File] for sources that cannot be mapped!
+		//
+		class MappedFile : public Raw
+		{
+		public:
+			///////////////////////////////////////////////////////////////////
+			//
+			// Construction
+			//
+
+			// Default constructor for empty source
+			MappedFile() = default;
+
+			// Memory mapping cannot be shared
+			MappedFile( const MappedFile& ) = delete;
+			MappedFile( MappedFile&& ) = delete;
+
+			// Construct for a named file (which must exist!)
+			// WARNING: Throws [eon::source::BadName] if the name is not for
+			//          an existing file that we can open for reading!
+			// WARNING: Throws [eon::source::NotMappable] if the file exists
+			//          but cannot be memory mapped!
+			MappedFile( const string& name );
+
+
+			// Unmaps the file
+			virtual ~MappedFile() { _unmap(); }
+
+
+
+
+			///////////////////////////////////////////////////////////////////
+			//
+			// Read-only Methods
+			//
+		public:
+
+			inline size_t numBytesInSource() const noexcept override { return NumBytes; }
+
+			// Given a base position and an offset (in characaters, not bytes!),
+			// get a source::Pos object for that offset.
+			// If 'offset_chars' refers to a character before start or after
+			// end of source, it will be adjusted to fit.
+			// Returns 'base_position' if 'offset_chars' is adjusted to zero!
+			Pos getPosAtOffset( Pos base_position, int offset_chars = 1 ) override;
+
+			// Check if the portion of the source between 'start' and 'end' matches the specified string 'value'.
+			bool match( const Pos& start, const Pos& end, const eon::string& value ) const noexcept override;
+
+			// Check if the portion of the source between 'start' and 'end' matches the specified string 'value'.
+			bool match( const Pos& start, const Pos& end, const char* value ) const noexcept override;
+
+			// Get characater at specified position
+			// Returns [eon::nochar] if at or beyond source end!
+			char_t chr( const Pos& pos ) noexcept override;
+
+			// Get byte at specified position
+			// Returns -1 if at or beyond source end!
+			inline int byte( index_t pos ) noexcept override {
+				return pos < NumBytes ? static_cast<int>( static_cast<byte_t>( Data[ pos ] ) ) : -1; }
+
+			// Get string at specified area
+			// Returns empty string if not a valid area or the entire area is
+			// outside the scope of the source!
+			string str( Pos start, Pos end ) noexcept override;
+
+			// Get bytes at specified area.
+			// Returns empty if not a valid area or the entire area is outside the scope of the source!
+			std::string bytes( Pos start, Pos end ) noexcept override;
+
+			// Get a substring referencing the specified area directly in the
+			// mapped memory, no copying is done.
+			// Returns an empty substring if not a valid area or the entire
+			// area is outside the scope of the source!
+			// WARNING: The substring is only valid for as long as 'this'
+			//          source exists!
+			substring view( Pos start, Pos end ) const noexcept;
+
+
+
+
+			///////////////////////////////////////////////////////////////////
+			//
+			// Helpers
+			//
+		PRIVATE:
+
+			void _map();
+			void _unmap() noexcept;
+
+			// Adjust end position and check if area is valid.
+			bool _area( const Pos& start, Pos& end ) const noexcept;
+
+			void _forward( Pos& pos, index_t num_chars );
+			void _backward( Pos& pos, index_t num_chars );
+
+			void _scanFile();
+
+
+
+
+			///////////////////////////////////////////////////////////////////
+			//
+			// Attributes
+			//
+		private:
+
+			const char* Data{ nullptr };
+			size_t NumBytes{ 0 };
+#ifdef EON_WINDOWS
+			void* FileHandle{ nullptr };
+			void* MapHandle{ nullptr };
+#endif
+		};
+	}
+}
\ No newline at end of file
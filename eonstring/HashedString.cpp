@@ -0,0 +1,45 @@
+#include "HashedString.h"
+#include <eoninlinetest/InlineTest.h>
+
+
+namespace eon
+{
+	EON_TEST( hashed_string, hash64, same_as_string,
+		EON_EQ( string( "Hello World!" ).hash64(), hashed_string( "Hello World!" ).hash64() ) );
+	EON_TEST_3STEP( hashed_string, hash64, cached,
+		hashed_string obj( "abc" ),
+		obj.hash64(),
+		EON_TRUE( obj.hashed() ) );
+	EON_TEST_2STEP( hashed_string, hash64, not_cached,
+		hashed_string obj( "abc" ),
+		EON_FALSE( obj.hashed() ) );
+
+	EON_TEST_3STEP( hashed_string, operator_plusasgn, reset,
+		hashed_string obj( "abc" ),
+		obj.hash64(),
+		EON_FALSE( ( obj += string( "def" ) ).hashed() ) );
+	EON_TEST_3STEP( hashed_string, operator_plusasgn, rehash,
+		hashed_string obj( "abc" ),
+		obj.hash64(); obj += string( "def" ),
+		EON_EQ( string( "abcdef" ).hash64(), obj.hash64() ) );
+
+	EON_TEST_3STEP( hashed_string, modify, reset,
+		hashed_string obj( "abc" ),
+		obj.hash64(); obj.modify( []( string& str ) { str = str.upper(); } ),
+		EON_EQ( string( "ABC" ).hash64(), obj.hash64() ) );
+
+	EON_TEST_3STEP( hashed_string, operator_eq, cached_copy,
+		hashed_string obj( "abc" ),
+		obj.hash64(),
+		EON_TRUE( hashed_string( obj ) == obj ) );
+	EON_TEST( hashed_string, operator_eq, different,
+		EON_FALSE( hashed_string( "abc" ) == hashed_string( "abd" ) ) );
+
+	uint64_t hashed_string::_hash() const noexcept
+	{
+		auto hash = Value.hash64();
+		Hash.store( hash, std::memory_order_relaxed );
+		return hash;
+	}
+	EON_NO_TEST( hashed_string, _hash );
+}
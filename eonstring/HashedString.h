@@ -0,0 +1,219 @@
+#pragma once
+#include "String.h"
+#include <atomic>
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// The 'eon' namespace encloses all public functionality
+//
+namespace eon
+{
+	///////////////////////////////////////////////////////////////////////////
+	//
+	// Eon Hashed String Class - eon::hashed_string
+	//
+	// An [eon::string] that caches its own 64-bit FNV-1a hash value.
+	// The hash is computed the first time it is needed and is kept until the
+	// string is modified. Use this instead of [eon::string] for keys in
+	// 'std::unordered_map' and 'std::unordered_set' that are looked up
+	// repeatedly, as each lookup then costs O(1) for hashing instead of
+	// O(n).
+	//
+	// Read access to the string is through [str], modifying is only possible
+	// through the methods of this class (which will discard the cached hash).
+	//
+	// NOTE: Short strings are stored inline (small string optimization) as
+	//       with [eon::string], the cache adds 8 bytes.
+	// NOTE: Computing the hash from multiple threads at the same time is safe.
+	//
+	class hashed_string
+	{
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Construction
+		//
+	public:
+
+		// Construct an empty string.
+		hashed_string() = default;
+
+		// Construct as a copy of another hashed string, including cached hash.
+		inline hashed_string( const hashed_string& other ) { *this = other; }
+
+		// Construct by taking ownership of another hashed string.
+		inline hashed_string( hashed_string&& other ) noexcept { *this = std::move( other ); }
+
+		// Construct as a copy of a string.
+		inline hashed_string( const string& value ) : Value( value ) {}
+
+		// Construct by taking ownership of a string.
+		inline hashed_string( string&& value ) noexcept : Value( std::move( value ) ) {}
+
+		// Construct as a copy of a substring.
+		// WARNING: Throws [eon::InvalidUTF8] if input is not valid UTF-8!
+		inline hashed_string( const substring& value ) : Value( value ) {}
+
+		// Construct as a copy of a C string.
+		// WARNING: Throws [eon::InvalidUTF8] if input is not valid UTF-8!
+		inline hashed_string( const char* value ) : Value( value ) {}
+
+		// Construct as a copy of a [std::string].
+		// WARNING: Throws [eon::InvalidUTF8] if input is not valid UTF-8!
+		inline hashed_string( const std::string& value ) : Value( value ) {}
+
+
+		virtual ~hashed_string() = default;
+
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Modifier Methods
+		//
+	public:
+
+		// Discard current value and copy that of another hashed string, including cached hash.
+		inline hashed_string& operator=( const hashed_string& other ) {
+			Value = other.Value; Hash.store( other.Hash.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+			return *this; }
+
+		// Discard current value and take ownership of that of another hashed string.
+		inline hashed_string& operator=( hashed_string&& other ) noexcept {
+			Value = std::move( other.Value ); Hash.store( other.Hash.exchange( 0, std::memory_order_relaxed ),
+				std::memory_order_relaxed ); return *this; }
+
+		// Discard current value and copy a string.
+		inline hashed_string& operator=( const string& value ) { Value = value; _reset(); return *this; }
+
+		// Discard current value and take ownership of a string.
+		inline hashed_string& operator=( string&& value ) noexcept {
+			Value = std::move( value ); _reset(); return *this; }
+
+		// Append a string.
+		inline hashed_string& operator+=( const string& value ) { Value += value; _reset(); return *this; }
+
+		// Append a substring.
+		// WARNING: Throws [eon::InvalidUTF8] if input is not valid UTF-8!
+		inline hashed_string& operator+=( const substring& value ) { Value += value; _reset(); return *this; }
+
+		// Append a single character.
+		inline hashed_string& operator+=( char_t value ) { Value += value; _reset(); return *this; }
+
+		// Modify the string using a function (or lambda) taking 'eon::string&'
+		// as argument.
+		// NOTE: The string reference must not be kept beyond the call!
+		template<typename FunctionT>
+		inline hashed_string& modify( FunctionT func ) { func( Value ); _reset(); return *this; }
+
+		// Clear the string.
+		inline void clear() noexcept { Value.clear(); _reset(); }
+
+		// Take ownership of the string, leaving 'this' empty.
+		inline string release() noexcept { _reset(); return std::move( Value ); }
+
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Read-only Methods
+		//
+	public:
+
+		// Access the string
+		inline const string& str() const noexcept { return Value; }
+		inline operator const string&() const noexcept { return Value; }
+
+		// Get substring for the entire string
+		inline substring substr() const { return Value.substr(); }
+
+		inline index_t numChars() const noexcept { return Value.numChars(); }
+		inline index_t numBytes() const noexcept { return Value.numBytes(); }
+		inline bool empty() const noexcept { return Value.empty(); }
+
+
+		// Get 64-bit hash value using FNV-1a hash algorithm.
+		// Computed only on first call (after modification), cached value is
+		// returned on later calls.
+		inline uint64_t hash64() const noexcept {
+			auto hash = Hash.load( std::memory_order_relaxed ); return hash != 0 ? hash : _hash(); }
+
+		// Get a 'size_t' size hash value.
+		inline size_t hash() const noexcept { return static_cast<size_t>( hash64() ); }
+
+		// Check if the hash value is currently cached.
+		inline bool hashed() const noexcept { return Hash.load( std::memory_order_relaxed ) != 0; }
+
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Comparison
+		//
+		// Equality is checked using cached hash values first (if both are
+		// cached), then bytes. Ordering is the same as for [eon::string].
+		//
+	public:
+
+		inline bool operator==( const hashed_string& other ) const noexcept {
+			auto a = Hash.load( std::memory_order_relaxed ), b = other.Hash.load( std::memory_order_relaxed );
+			return ( a == 0 || b == 0 || a == b ) && Value.stdstr() == other.Value.stdstr(); }
+		inline bool operator!=( const hashed_string& other ) const noexcept { return !( *this == other ); }
+
+		inline bool operator<( const hashed_string& other ) const noexcept { return Value < other.Value; }
+		inline bool operator<=( const hashed_string& other ) const noexcept { return Value <= other.Value; }
+		inline bool operator>( const hashed_string& other ) const noexcept { return Value > other.Value; }
+		inline bool operator>=( const hashed_string& other ) const noexcept { return Value >= other.Value; }
+
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Helpers
+		//
+	PRIVATE:
+
+		inline void _reset() noexcept { Hash.store( 0, std::memory_order_relaxed ); }
+		uint64_t _hash() const noexcept;
+
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Attributes
+		//
+	PRIVATE:
+
+		string Value;
+
+		// Zero if not computed. (Should a string actually hash to zero, it
+		// will simply not be cached.)
+		mutable std::atomic<uint64_t> Hash{ 0 };
+	};
+}
+
+
+namespace std
+{
+	// Allow implicit use of [eon::hashed_string] as key when used in
+	// containers such as 'std::unordered_map' and 'std::unordered_set'.
+	template<>
+	struct hash<::eon::hashed_string> {
+		inline size_t operator()( const ::eon::hashed_string& rhs ) const noexcept { return rhs.hash(); } };
+
+	// Allow implicit use of [eon::hashed_string] as value when used in
+	// containers such as 'std::unordered_map' and 'std::unordered_set'.
+	template<>
+	struct equal_to<::eon::hashed_string> {
+		inline bool operator()( const ::eon::hashed_string& lhs, const ::eon::hashed_string& rhs ) const noexcept {
+			return lhs == rhs; } };
+
+
+	// Allow [eon::hashed_string] to be serialized to 'std::ostream' objects.
+	inline ostream& operator<<( ostream& o, const ::eon::hashed_string& str ) { o << str.str().stdstr(); return o; }
+}
@@ -128,5 +128,19 @@ namespace eon
 		Num = &std::use_facet<std::numpunct<wchar_t>>( Loc );
 		CType = &std::use_facet<std::ctype<wchar_t>>( Loc );
 		Money = &std::use_facet<std::moneypunct<wchar_t>>( Loc );
+
+		wchar_t lower[ 128 ];
+		for( int i = 0; i < 128; ++i )
+			lower[ i ] = static_cast<wchar_t>( i );
+		CType->tolower( lower, lower + 128 );
+		AsciiFoldable = true;
+		for( int i = 0; i < 128; ++i )
+		{
+			if( lower[ i ] < 0 || lower[ i ] > 127 )
+				AsciiFoldable = false;
+			AsciiFold[ i ] = static_cast<char>( lower[ i ] & 0x7F );
+		}
 	}
+	EON_TEST( locale, asciiFold, standard,
+		EON_TRUE( locale::get().asciiFold() != nullptr && locale::get().asciiFold()[ 'A' ] == 'a' ) );
 }
@@ -132,6 +132,12 @@ namespace eon
 		// Returns the same character if no lower-case version exists!
 		inline wchar_t toLower( wchar_t value ) const { return CType->tolower( value ); }
 
+		// Get a table of 128 bytes mapping each ASCII character to its
+		// lower-case version, for byte-level case-insensitive searching.
+		// Returns nullptr if the locale maps any ASCII character to a non-
+		// ASCII one (such as Turkish dotless 'i')!
+		inline const char* asciiFold() const noexcept { return AsciiFoldable ? AsciiFold : nullptr; }
+
 
 
 
@@ -196,6 +202,9 @@ namespace eon
 		const std::ctype<wchar_t>* CType{ nullptr };
 		const std::moneypunct<wchar_t>* Money{ nullptr };
 
+		char AsciiFold[ 128 ]{};
+		bool AsciiFoldable{ false };
+
 		static thread_local locale CurLocale;
 	};
 }
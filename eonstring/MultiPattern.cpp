@@ -0,0 +1,186 @@
+#include "MultiPattern.h"
+#include <eoninlinetest/InlineTest.h>
+
+
+namespace eon
+{
+	multipattern::multipattern( const std::map<string, string>& find_replace )
+	{
+		Patterns.reserve( find_replace.size() );
+		for( auto& elm : find_replace )
+		{
+			if( !elm.first.empty() )
+				Patterns.push_back( elm );
+		}
+		_compile();
+	}
+	EON_TEST( multipattern, multipattern, map,
+		EON_EQ( 2, multipattern( std::map<string, string>EON_CURLY(
+			EON_CURLY( "ab", "x" ), EON_CURLY( "cd", "y" ) ) ).size() ) );
+	EON_TEST( multipattern, multipattern, map_empty_key,
+		EON_EQ( 1, multipattern( std::map<string, string>EON_CURLY(
+			EON_CURLY( "", "x" ), EON_CURLY( "cd", "y" ) ) ).size() ) );
+
+	multipattern::multipattern( const std::vector<string>& patterns )
+	{
+		Patterns.reserve( patterns.size() );
+		for( auto& pattern : patterns )
+		{
+			if( !pattern.empty() )
+				Patterns.push_back( std::make_pair( pattern, string() ) );
+		}
+		_compile();
+	}
+	EON_TEST( multipattern, multipattern, vector,
+		EON_EQ( 6, multipattern( std::vector<string>EON_CURLY( "ab", "cd", "abc" ) ).numStates() ) );
+
+
+
+
+	substring multipattern::findFirst( const substring& area, index_t* pattern_no ) const noexcept
+	{
+		auto real_area = area.lowToHigh();
+		index_t no = 0;
+		auto found = findFirst( real_area.begin().byteData(), real_area.end().byteData(), no );
+		if( found == nullptr )
+			return substring( real_area.end().getEnd() );
+		if( pattern_no != nullptr )
+			*pattern_no = no;
+
+		// Count characters up to the match, only once
+		index_t num_char = 0;
+		string_iterator::scanUtf8( real_area.begin().byteData(), found, num_char );
+		num_char += real_area.begin().numChar();
+		return substring(
+			string_iterator( real_area.begin(), found, num_char ),
+			string_iterator( real_area.begin(), found + Patterns[ no ].first.numBytes(),
+				num_char + Patterns[ no ].first.numChars() ) );
+	}
+	EON_TEST_2STEP( multipattern, findFirst, none,
+		string obj( "abcdef" ),
+		EON_FALSE( multipattern( std::vector<string>EON_CURLY( "x", "ce" ) ).findFirst( obj.substr() ) ) );
+	EON_TEST_2STEP( multipattern, findFirst, single,
+		string obj( "abcdef" ),
+		EON_EQ( obj.substr( 2, 2 ), multipattern( std::vector<string>EON_CURLY( "x", "cd" ) ).findFirst( obj.substr() ) ) );
+	EON_TEST_2STEP( multipattern, findFirst, leftmost,
+		string obj( "abcdef" ),
+		EON_EQ( obj.substr( 1, 4 ), multipattern( std::vector<string>EON_CURLY( "cd", "bcde" ) ).findFirst(
+			obj.substr() ) ) );
+	EON_TEST_2STEP( multipattern, findFirst, shortest,
+		string obj( "abcdef" ),
+		EON_EQ( obj.substr( 1, 2 ), multipattern( std::vector<string>EON_CURLY( "bcd", "bc" ) ).findFirst(
+			obj.substr() ) ) );
+	EON_TEST_2STEP( multipattern, findFirst, UTF8,
+		string obj( u8"\u00D8a\u20A0\u0153\u2122" ),
+		EON_EQ( obj.substr( 2, 2 ), multipattern( std::vector<string>EON_CURLY( u8"\u20A0\u0153", u8"a\u2122" ) ).findFirst(
+			obj.substr() ) ) );
+	EON_TEST_3STEP( multipattern, findFirst, pattern_no,
+		string obj( "abcdef" ); index_t pattern_no = 9,
+		multipattern( std::vector<string>EON_CURLY( "x", "de" ) ).findFirst( obj.substr(), &pattern_no ),
+		EON_EQ( 1, pattern_no ) );
+
+	const char* multipattern::findFirst( const char* begin, const char* end, index_t& pattern_no ) const noexcept
+	{
+		if( Patterns.empty() )
+			return nullptr;
+
+		// Leftmost match wins. Since every pattern starting at the same
+		// position as the current candidate will be longer (and we want the
+		// shortest), we only have to keep going for as long as the current
+		// state can lead to a match starting earlier than the candidate.
+		const char* candidate = nullptr;
+		uint32_t state = 0;
+		for( auto c = begin; c != end; ++c )
+		{
+			state = _next( state, *c );
+			auto output = Output[ state ];
+			if( output != NoPattern )
+			{
+				auto start = c + 1 - Patterns[ output ].first.numBytes();
+				if( candidate == nullptr || start < candidate )
+				{
+					candidate = start;
+					pattern_no = output;
+				}
+			}
+			if( candidate != nullptr && c + 1 - Depth[ state ] >= candidate )
+				return candidate;
+		}
+		return candidate;
+	}
+
+
+
+
+	void multipattern::_compile()
+	{
+		// Bytes used in any pattern get their own class
+		ByteClass.fill( 0 );
+		NumClasses = 1;
+		for( auto& pattern : Patterns )
+		{
+			for( auto c = pattern.first.c_str(), end = c + pattern.first.numBytes(); c != end; ++c )
+			{
+				auto& cls = ByteClass[ static_cast<byte_t>( *c ) ];
+				if( cls == 0 )
+					cls = static_cast<uint16_t>( NumClasses++ );
+			}
+		}
+
+		// Build the trie, zero meaning no transition (as the root is never a
+		// child).
+		Transitions.assign( NumClasses, 0 );
+		Depth.assign( 1, 0 );
+		std::vector<uint32_t> terminal{ NoPattern };
+		for( uint32_t no = 0; no < Patterns.size(); ++no )
+		{
+			uint32_t state = 0;
+			auto& pattern = Patterns[ no ].first;
+			for( auto c = pattern.c_str(), end = c + pattern.numBytes(); c != end; ++c )
+			{
+				auto& next = Transitions[ state * NumClasses + ByteClass[ static_cast<byte_t>( *c ) ] ];
+				if( next == 0 )
+				{
+					auto new_state = static_cast<uint32_t>( Depth.size() );
+					next = new_state;
+					Transitions.resize( Transitions.size() + NumClasses, 0 );
+					Depth.push_back( Depth[ state ] + 1 );
+					terminal.push_back( NoPattern );
+					state = new_state;
+				}
+				else
+					state = next;
+			}
+			if( terminal[ state ] == NoPattern )
+				terminal[ state ] = no;
+		}
+
+		// Breadth first, add failure transitions (making the automaton a
+		// complete DFA) and find the longest output for each state.
+		std::vector<uint32_t> failure( Depth.size(), 0 ), queue;
+		queue.reserve( Depth.size() );
+		Output.assign( Depth.size(), NoPattern );
+		for( index_t cls = 0; cls < NumClasses; ++cls )
+		{
+			if( Transitions[ cls ] != 0 )
+				queue.push_back( Transitions[ cls ] );
+		}
+		for( size_t i = 0; i < queue.size(); ++i )
+		{
+			auto state = queue[ i ];
+			Output[ state ] = terminal[ state ] != NoPattern ? terminal[ state ] : Output[ failure[ state ] ];
+			for( index_t cls = 0; cls < NumClasses; ++cls )
+			{
+				auto& next = Transitions[ state * NumClasses + cls ];
+				auto fail_next = Transitions[ failure[ state ] * NumClasses + cls ];
+				if( next != 0 )
+				{
+					failure[ next ] = fail_next;
+					queue.push_back( next );
+				}
+				else
+					next = fail_next;
+			}
+		}
+	}
+}
@@ -0,0 +1,146 @@
+#pragma once
+#include "String.h"
+#include <map>
+#include <vector>
+#include <array>
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// The 'eon' namespace encloses all public functionality
+//
+namespace eon
+{
+	///////////////////////////////////////////////////////////////////////////
+	//
+	// Eon Multi-Pattern Class - eon::multipattern
+	//
+	// A set of literal patterns (each with a replacement string), compiled
+	// into an Aho-Corasick automaton so that the occurrences of all patterns
+	// can be located in a single linear pass over the input.
+	//
+	// Compile once and reuse for repeated searches and replacements, see
+	// [eon::string::replace( const multipattern&, const substring& )].
+	//
+	// Matching is on UTF-8 bytes and is exact (case sensitive). When several
+	// patterns match, the one starting first wins, and of those starting at
+	// the same position, the shortest wins. (This is the same as the first
+	// matching key in a 'std::map<eon::string, eon::string>'.)
+	//
+	// NOTE: Empty patterns are ignored!
+	//
+	class multipattern
+	{
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Construction
+		//
+	public:
+
+		// Construct an empty pattern set, matching nothing.
+		multipattern() = default;
+
+		multipattern( const multipattern& ) = default;
+		multipattern( multipattern&& ) noexcept = default;
+
+		// Construct for the keys of a map, with the values as replacements.
+		explicit multipattern( const std::map<string, string>& find_replace );
+
+		// Construct for a list of patterns, without replacements.
+		explicit multipattern( const std::vector<string>& patterns );
+
+
+		virtual ~multipattern() = default;
+
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Modifier Methods
+		//
+	public:
+
+		multipattern& operator=( const multipattern& ) = default;
+		multipattern& operator=( multipattern&& ) noexcept = default;
+
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Read-only Methods
+		//
+	public:
+
+		// Get number of patterns.
+		inline index_t size() const noexcept { return static_cast<index_t>( Patterns.size() ); }
+
+		// Check if there are no patterns.
+		inline bool empty() const noexcept { return Patterns.empty(); }
+
+		// Get pattern by number (in the order they were given).
+		inline const string& pattern( index_t pattern_no ) const noexcept { return Patterns[ pattern_no ].first; }
+
+		// Get replacement for a pattern.
+		inline const string& replacement( index_t pattern_no ) const noexcept { return Patterns[ pattern_no ].second; }
+
+		// Get number of states in the compiled automaton.
+		inline index_t numStates() const noexcept { return static_cast<index_t>( Depth.size() ); }
+
+
+		// Find the first occurrence of any of the patterns within 'area'.
+		// NOTE: Search is done in 'low-to-high' ordering regardless of 'area' settings!
+		// If 'pattern_no' is specified, it will be set to the number of the
+		// matching pattern.
+		// Returns the found substring - 'false' substring if not found.
+		substring findFirst( const substring& area, index_t* pattern_no = nullptr ) const noexcept;
+
+		// Find the first occurrence of any of the patterns within the raw
+		// bytes from 'begin' to 'end'.
+		// Sets 'pattern_no' to the number of the matching pattern.
+		// Returns address of the first byte of the match, nullptr if not found.
+		const char* findFirst( const char* begin, const char* end, index_t& pattern_no ) const noexcept;
+
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Helpers
+		//
+	PRIVATE:
+
+		void _compile();
+
+		inline uint32_t _next( uint32_t state, char byte ) const noexcept {
+			return Transitions[ state * NumClasses + ByteClass[ static_cast<byte_t>( byte ) ] ]; }
+
+
+
+
+		///////////////////////////////////////////////////////////////////////
+		//
+		// Attributes
+		//
+	PRIVATE:
+
+		static constexpr uint32_t NoPattern{ UINT32_MAX };
+
+		std::vector<std::pair<string, string>> Patterns;
+
+		// Bytes not used by any pattern all share class 0.
+		std::array<uint16_t, 256> ByteClass{};
+		index_t NumClasses{ 1 };
+
+		// Complete transition table, 'NumClasses' entries per state. State 0
+		// is the root.
+		std::vector<uint32_t> Transitions;
+
+		// Length (in bytes) of the longest pattern prefix matched by each state.
+		std::vector<uint32_t> Depth;
+
+		// For each state, the longest pattern ending there ([NoPattern] if none).
+		std::vector<uint32_t> Output;
+	};
+}
@@ -11,8 +11,8 @@ namespace eon
 
 	inline void init()
 	{
-		if( !Data )
-			Data = new NameData();
+		// Thread-safe, one-time initialization
+		[[maybe_unused]] static NameData* instance{ Data = new NameData() };
 	}
 
 	const string& str( const name_t& name )
@@ -40,4 +40,13 @@ namespace eon
 	}
 	EON_TEST( name, compilerName, basic,
 		EON_EQ( string( "!compiler name" ), str( compilerName( "!compiler name" ) ) ) );
+
+	NameData::Stats nameStats()
+	{
+		init();
+		return Data->stats();
+	}
+	EON_TEST_2STEP( name, nameStats, basic,
+		name( "stats_test" ),
+		EON_TRUE( nameStats().Count > 0 && nameStats().Bytes >= 10 ) );
 }
@@ -75,6 +75,9 @@ namespace eon
 	// Such names can contain non-name characters
 	name_t compilerName( string&& str );
 
+	// Get memory usage details for all names registered so far
+	NameData::Stats nameStats();
+
 #ifdef _DEBUG
 	static NameData* Data{ nullptr };
 #endif
@@ -6,21 +6,35 @@ namespace eon
 	const string NameData::NullStr;
 
 
+	NameData::NameData()
+	{
+		// Default names all go into the first segment, in id order. No
+		// locking is needed since no one else can see us yet!
+		static_assert( defaultname::count < SegmentSize, "Default names must fit in the first segment" );
+		auto arena = new Segment();
+		for( uint32_t i = 0; i < defaultname::count; ++i )
+		{
+			arena->Names[ i ] = string( defaultname::strings[ i ] );
+			NumBytes.fetch_add( arena->Names[ i ].numBytes(), std::memory_order_relaxed );
+			arena->Ready[ i ].store( true, std::memory_order_relaxed );
+			auto hash = arena->Names[ i ].fastHash();
+			_insert( Shards[ hash >> ShardShift ], hash, i + 1 );
+		}
+		Segments[ 0 ].store( arena, std::memory_order_release );
+		NextID.store( defaultname::count + 1, std::memory_order_release );
+	}
+		NameData::~NameData()
+	{
+		for( auto& segment : Segments )
+			delete segment.load( std::memory_order_acquire );
+	}
+
+
 	name_t NameData::name( string&& str ) noexcept
 	{
 		if( !validName( str ) )
 			return no_name;
-		std::lock_guard<std::mutex> lock( Lock );
-		auto found = Lookup.find( &str );
-		if( found != Lookup.end() )
-		{
-			str.clear();		// For consistency!
-			return found->second;
-		}
-		Names.push_back( new string( std::move( str ) ) );
-		name_t id( Names.size() );
-		Lookup[ Names[ Names.size() - 1 ] ] = id;
-		return id;
+		return _lookupOrInsert( std::move( str ) );
 	}
 
 	bool NameData::validName( const string& str ) noexcept
@@ -41,16 +55,138 @@ namespace eon
 	{
 		if( str.empty() )
 			return no_name;
-		std::lock_guard<std::mutex> lock( Lock );
-		auto found = Lookup.find( &str );
-		if( found != Lookup.end() )
+		return _lookupOrInsert( std::move( str ) );
+	}
+
+
+	NameData::Stats NameData::stats() const
+	{
+		Stats stats;
+		stats.Count = size();
+		stats.Bytes = NumBytes.load( std::memory_order_relaxed );
+		stats.HeapBytes = NumHeapBytes.load( std::memory_order_relaxed );
+		for( auto& segment : Segments )
+		{
+			if( segment.load( std::memory_order_relaxed ) != nullptr )
+				stats.ArenaBytes += sizeof( Segment );
+		}
+		size_t used = 0, capacity = 0;
+		for( auto& shard : Shards )
+		{
+			std::shared_lock<std::shared_mutex> lock( shard.Lock );
+			used += shard.Used;
+			capacity += shard.Index.size();
+		}
+		stats.IndexBytes = capacity * sizeof( IndexEntry );
+		stats.LoadFactor = capacity > 0 ? static_cast<double>( used ) / static_cast<double>( capacity ) : 0.0;
+		return stats;
+	}
+
+
+	name_t NameData::_lookupOrInsert( string&& str )
+	{
+		auto hash = str.fastHash();
+		auto& shard = Shards[ hash >> ShardShift ];
+		{
+			std::shared_lock<std::shared_mutex> lock( shard.Lock );
+			auto found = _find( shard, hash, str );
+			if( found != no_name )
+			{
+				str.clear();		// For consistency!
+				return found;
+			}
+		}
+
+		std::unique_lock<std::shared_mutex> lock( shard.Lock );
+		auto found = _find( shard, hash, str );
+		if( found != no_name )
 		{
 			str.clear();		// For consistency!
-			return found->second;
+			return found;
+		}
+
+		auto id = NextID.fetch_add( 1, std::memory_order_relaxed );
+		auto segment_no = ( id - 1 ) / SegmentSize;
+		if( segment_no >= NumSegments )
+			return no_name;
+		auto& segment = Segments[ segment_no ];
+		auto arena = segment.load( std::memory_order_acquire );
+		if( arena == nullptr )
+		{
+			// Another shard may be allocating the same segment, first one to publish wins!
+			auto new_arena = new Segment();
+			if( segment.compare_exchange_strong( arena, new_arena, std::memory_order_acq_rel ) )
+				arena = new_arena;
+			else
+				delete new_arena;
+		}
+		auto slot = ( id - 1 ) % SegmentSize;
+		NumBytes.fetch_add( str.numBytes(), std::memory_order_relaxed );
+		arena->Names[ slot ] = std::move( str );
+		auto& bytes = arena->Names[ slot ].stdstr();
+		if( bytes.c_str() < (const char*)&bytes || bytes.c_str() >= (const char*)&bytes + sizeof( std::string ) )
+			NumHeapBytes.fetch_add( bytes.capacity() + 1, std::memory_order_relaxed );
+		arena->Ready[ slot ].store( true, std::memory_order_release );
+
+		_insert( shard, hash, id );
+		return name_t( id );
+	}
+
+	const string* NameData::_entry( name_t name ) const noexcept
+	{
+		if( name == no_name )
+			return nullptr;
+		auto index = name.value() - 1;
+		if( index / SegmentSize >= NumSegments )
+			return nullptr;
+		auto arena = Segments[ index / SegmentSize ].load( std::memory_order_acquire );
+		if( arena == nullptr || !arena->Ready[ index % SegmentSize ].load( std::memory_order_acquire ) )
+			return nullptr;
+		return &arena->Names[ index % SegmentSize ];
+	}
+
+	name_t NameData::_find( const Shard& shard, uint64_t hash, const string& str ) const noexcept
+	{
+		if( shard.Index.empty() )
+			return no_name;
+		auto mask = shard.Index.size() - 1;
+		for( auto pos = hash & mask; ; pos = ( pos + 1 ) & mask )
+		{
+			auto& entry = shard.Index[ pos ];
+			if( entry.ID == 0 )
+				return no_name;
+			if( entry.Hash == hash && *_entry( name_t( entry.ID ) ) == str )
+				return name_t( entry.ID );
+		}
+	}
+
+	void NameData::_insert( Shard& shard, uint64_t hash, uint32_t id )
+	{
+		if( ( shard.Used + 1 ) * 10 > shard.Index.size() * 7 )
+			_grow( shard );
+		auto mask = shard.Index.size() - 1;
+		auto pos = hash & mask;
+		while( shard.Index[ pos ].ID != 0 )
+			pos = ( pos + 1 ) & mask;
+		shard.Index[ pos ].Hash = hash;
+		shard.Index[ pos ].ID = id;
+		++shard.Used;
+	}
+
+		void NameData::_grow( Shard& shard )
+	{
+		// Rehashing is done using the stored hash values, no strings are touched!
+		std::vector<IndexEntry> index( shard.Index.empty() ? MinIndexSize : shard.Index.size() * 2 );
+		auto mask = index.size() - 1;
+		for( auto& entry : shard.Index )
+		{
+			if( entry.ID == 0 )
+				continue;
+			auto pos = entry.Hash & mask;
+			while( index[ pos ].ID != 0 )
+				pos = ( pos + 1 ) & mask;
+			index[ pos ] = entry;
 		}
-		Names.push_back( new string( std::move( str ) ) );
-		name_t id( Names.size() );
-		Lookup[ Names[ Names.size() - 1 ] ] = id;
-		return id;
+		shard.Index = std::move( index );
 	}
 }
@@ -1,9 +1,13 @@
 #pragma once
 #include "NameDefs.h"
 #include "String.h"
+#include "DefaultNames.h"
 #include <set>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
 #include <unordered_map>
+#include <vector>
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -16,27 +20,97 @@ namespace eon
 	//
 	// Underlying implementation of eon::name handling
 	//
+	// Names are stored in an arena of fixed size segments, each holding a
+	// contiguous block of string objects. Segments are published atomically
+	// and never moved or freed, so looking up the string of a name is
+	// wait-free. (Names short enough for small string optimization have
+	// their bytes stored directly inside the arena.)
+	//
+	// Looking up the name of a string (and inserting new names) goes through
+	// a set of shards, each with its own lock, selected by string hash. Each
+	// shard has an open addressing hash index of precomputed (fast) hash and
+	// name id pairs. Only inserting new names requires exclusive access (to
+	// one shard).
+	//
+	// The default names (see [eon::defaultname]) are seeded in bulk when the
+	// table is created, using the fixed ids assigned to them at compile
+	// time.
+	//
 
-	struct hash_name { inline size_t operator()( const string* a ) const noexcept { return a->hash(); } };
+	struct hash_name { inline size_t operator()( const string* a ) const noexcept { return static_cast<size_t>( a->fastHash() ); } };
 	struct eq_name { inline bool operator()( const string* a, const string* b ) const noexcept { return *a == *b; } };
 	class NameData
 	{
 	public:
-		NameData() = default;
-		~NameData() { std::lock_guard<std::mutex> lock( Lock ); for( auto elm : Names ) delete elm; }
+		NameData();
+		NameData( const NameData& ) = delete;
+		NameData( NameData&& ) = delete;
+		~NameData();
 
-		inline const string& str( const name_t& name ) { std::lock_guard<std::mutex> lock( Lock );
-			return ( name > no_name && name.value() <= Names.size() ) ? *Names[ name.value() - 1 ] : NullStr; }
+		inline const string& str( const name_t& name ) const noexcept {
+			auto entry = _entry( name ); return entry != nullptr ? *entry : NullStr; }
 
 		name_t name( string&& str ) noexcept;
 		name_t compilerName( string&& str );
 
 		static bool validName( const string& str ) noexcept;
 
+		// Get number of names registered
+		inline size_t size() const noexcept { return NextID.load( std::memory_order_relaxed ) - 1; }
+
+
+		// Memory usage details
+		struct Stats
+		{
+			size_t Count{ 0 };			// Number of names
+			size_t Bytes{ 0 };			// Number of bytes in all names
+			size_t ArenaBytes{ 0 };		// Bytes allocated for arena segments
+			size_t HeapBytes{ 0 };		// Bytes allocated outside arena (long names)
+			size_t IndexBytes{ 0 };		// Bytes allocated for hash indexes
+			double LoadFactor{ 0.0 };	// Overall hash index load factor
+		};
+
+		// Get memory usage details
+		Stats stats() const;
+
+	private:
+		name_t _lookupOrInsert( string&& str );
+		const string* _entry( name_t name ) const noexcept;
+
+		struct Shard;
+		name_t _find( const Shard& shard, uint64_t hash, const string& str ) const noexcept;
+		void _insert( Shard& shard, uint64_t hash, uint32_t id );
+		void _grow( Shard& shard );
+
 	private:
-		std::vector<string*> Names;
-		std::unordered_map<const string*, name_t, hash_name, eq_name> Lookup;
-		std::mutex Lock;
+		static const size_t SegmentSize{ 4096 };
+		static const size_t NumSegments{ 16384 };
+		struct Segment
+		{
+			string Names[ SegmentSize ];
+			std::atomic<bool> Ready[ SegmentSize ]{};
+		};
+		std::atomic<Segment*> Segments[ NumSegments ]{};
+		std::atomic<uint32_t> NextID{ 1 };
+		std::atomic<size_t> NumBytes{ 0 };
+		std::atomic<size_t> NumHeapBytes{ 0 };
+
+		struct IndexEntry
+		{
+			uint64_t Hash{ 0 };
+			uint32_t ID{ 0 };		// Zero means free
+		};
+		struct Shard
+		{
+			mutable std::shared_mutex Lock;
+			std::vector<IndexEntry> Index;
+			size_t Used{ 0 };
+		};
+		static const size_t NumShards{ 16 };
+		static const size_t ShardShift{ 60 };		// Use top 4 bits of hash for shard, the rest for index
+		static const size_t MinIndexSize{ 256 };
+		Shard Shards[ NumShards ];
+
 		static const string NullStr;
 	};
 }
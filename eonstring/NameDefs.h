@@ -26,18 +26,18 @@ namespace eon
 		name_t() = default;
 
 		// Construct a name from an unsigned 32 bit integer.
-		inline name_t( uint32_t value ) noexcept { Value = value; }
+		constexpr name_t( uint32_t value ) noexcept { Value = value; }
 
 		// Construct a name from an int - which will be converted into an unsigned 32 bit integer.
-		explicit inline name_t( int value ) noexcept { Value = static_cast<uint32_t>( value ); }
+		explicit constexpr name_t( int value ) noexcept { Value = static_cast<uint32_t>( value ); }
 
 #if INTPTR_MAX == INT64_MAX
 		// Construct a name from a size_t - which will be converted into an unsigned 32 bit integer.
-		explicit inline name_t( size_t value ) noexcept { Value = static_cast<uint32_t>( value ); }
+		explicit constexpr name_t( size_t value ) noexcept { Value = static_cast<uint32_t>( value ); }
 #endif
 
 		// Copy another name
-		inline name_t( const name_t& other ) noexcept { Value = other.Value; }
+		constexpr name_t( const name_t& other ) noexcept { Value = other.Value; }
 
 
 
@@ -49,14 +49,14 @@ namespace eon
 	public:
 
 		// Copy another name
-		inline name_t& operator=( const name_t& other ) noexcept { Value = other.Value; return *this; }
+		constexpr name_t& operator=( const name_t& other ) noexcept { Value = other.Value; return *this; }
 
 
 		// Get the name as an unsigned 32 bit integer.
-		inline uint32_t value() const noexcept { return Value; }
+		constexpr uint32_t value() const noexcept { return Value; }
 
 		// Allow the use of name_t as index.
-		inline operator size_t() const noexcept { return static_cast<size_t>( Value ); }
+		constexpr operator size_t() const noexcept { return static_cast<size_t>( Value ); }
 
 
 
@@ -68,22 +68,22 @@ namespace eon
 	public:
 
 		// Check if 'this' name sorts before 'other'.
-		inline bool operator<( const name_t& other ) const noexcept { return Value < other.Value; }
+		constexpr bool operator<( const name_t& other ) const noexcept { return Value < other.Value; }
 
 		// Check if 'this' name sorts before or same as 'other'.
-		inline bool operator<=( const name_t& other ) const noexcept { return Value <= other.Value; }
+		constexpr bool operator<=( const name_t& other ) const noexcept { return Value <= other.Value; }
 
 		// Check if 'this' name sorts after 'other'.
-		inline bool operator>( const name_t& other ) const noexcept { return Value > other.Value; }
+		constexpr bool operator>( const name_t& other ) const noexcept { return Value > other.Value; }
 
 		// Check if 'this' name sorts after or same as 'other'.
-		inline bool operator>=( const name_t& other ) const noexcept { return Value >= other.Value; }
+		constexpr bool operator>=( const name_t& other ) const noexcept { return Value >= other.Value; }
 
 		// Check if 'this' name sorts same as 'other'.
-		inline bool operator==( const name_t& other ) const noexcept { return Value == other.Value; }
+		constexpr bool operator==( const name_t& other ) const noexcept { return Value == other.Value; }
 
 		// Check if 'this' name sorts before or after 'other'.
-		inline bool operator!=( const name_t& other ) const noexcept { return Value != other.Value; }
+		constexpr bool operator!=( const name_t& other ) const noexcept { return Value != other.Value; }
 
 
 
@@ -98,8 +98,8 @@ namespace eon
 	};
 
 	// The null name
-	static const name_t no_name{ 0 };
-	static const name_t nn{ 0 };
+	static constexpr name_t no_name{ 0 };
+	static constexpr name_t nn{ 0 };
 }
 
 
@@ -113,5 +113,5 @@ namespace std
 		inline size_t operator()( const ::eon::name_t& a ) const { return Hasher( a.value() ); } };
 	template<>
 	struct equal_to<::eon::name_t> {
-		inline bool operator()( const ::eon::name_t& a, const ::eon::name_t& b ) const { return a == b; } };
+		constexpr bool operator()( const ::eon::name_t& a, const ::eon::name_t& b ) const { return a == b; } };
 }
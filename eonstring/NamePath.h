@@ -79,10 +79,11 @@ namespace eon
 				if( s.numChars() > 2 ) s += "/"; s += eon::str( name ); } return s; }
 
 
-		// Get hash value.
+		// Get hash value, using [eon::substring::fastHash] on the name values.
+		// Returns zero if empty.
 		inline size_t hash() const noexcept {
-			static std::hash<uint32_t> hasher;
-			size_t val{ 0 }; for( auto name : Value ) val = val * 37 + hasher( name.value() ); return val; }
+			return Value.empty() ? 0 : static_cast<size_t>( substring::fastHash( reinterpret_cast<const char*>(
+				Value.data() ), reinterpret_cast<const char*>( Value.data() + Value.size() ) ) ); }
 
 
 		// Comparison.
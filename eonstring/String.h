@@ -10,6 +10,8 @@
 #include <iomanip>
 #include <cmath>
 #include <unordered_map>
+#include <atomic>
+#include <vector>
 
 
 
@@ -33,6 +35,8 @@ namespace eon
 	// For internal use.
 	struct _TransformData;
 
+	class multipattern;
+
 
 
 
@@ -244,8 +248,8 @@ namespace eon
 #endif
 
 
-		// Default destructor.
-		virtual ~string() = default;
+		// Destructor, discards the character index (if any).
+		virtual ~string() { _dropCharIndex(); }
 
 
 	PRIVATE:
@@ -294,11 +298,13 @@ namespace eon
 
 
 		// Discard current details and copy those of another string.
-		inline string& operator=( const string& other ) { Bytes = other.Bytes; NumChars = other.NumChars; return *this; }
+		inline string& operator=( const string& other ) {
+			_dropCharIndex(); Bytes = other.Bytes; NumChars = other.NumChars; return *this; }
 
 		// Discard current details and take over ownership of those of another string.
 		inline string& operator=( string&& other ) noexcept {
-			Bytes = std::move( other.Bytes ); NumChars = other.NumChars; other.NumChars = 0; return *this; }
+			Bytes = std::move( other.Bytes ); NumChars = other.NumChars; other.NumChars = 0;
+			delete CharIndex.exchange( other.CharIndex.exchange( nullptr ) ); return *this; }
 
 
 		// Discard current details and copy new from a substring.
@@ -455,6 +461,21 @@ namespace eon
 		// string, or the byte position of 'start' is beyond 'pos'.
 		iterator bytePos( index_t pos, iterator start = iterator() ) const;
 
+		// Given a character position within the string, get an iterator for
+		// that position.
+		// Returns [end] if 'pos' is beyond the end of the string.
+		// NOTE: Constant time for ASCII strings. For long UTF-8 strings, a
+		//       sparse index of byte positions (for every [CharIndexStep]
+		//       character) is built on first use and kept until the string
+		//       is modified, limiting the counting to [CharIndexStep]
+		//       characters.
+		iterator charPos( index_t pos ) const;
+
+		// Get the character at the specified character position.
+		// Returns [eon::nochar] if 'pos' is beyond the end of the string.
+		// (See [eon::string::charPos] for performance.)
+		inline char_t at( index_t pos ) const { return *charPos( pos ); }
+
 
 		// Given an iterator for another string, get a new iterator for the same position in 'this'.
 		// Returns [end] if the iterator from the other string is beyond what 'this' string contains.
@@ -518,7 +539,7 @@ namespace eon
 	public:
 
 		// Clear the string contents
-		inline void clear() noexcept { Bytes.clear(); NumChars = 0; }
+		inline void clear() noexcept { _dropCharIndex(); Bytes.clear(); NumChars = 0; }
 
 		// Reserve memory in order to reduce the number of times the
 		// underlying string buffer may have to grow.
@@ -553,7 +574,8 @@ namespace eon
 
 
 		// Concatenate another string to 'this'.
-		inline string& operator+=( const string& other ) { Bytes += other.Bytes; NumChars += other.NumChars; return *this; }
+		inline string& operator+=( const string& other ) {
+			_dropCharIndex(); Bytes += other.Bytes; NumChars += other.NumChars; return *this; }
 
 		// Concatenate an substring to 'this'.
 		// WARNING: Throws [eon::InvalidUTF8] if input is not valid UTF-8!
@@ -737,9 +759,8 @@ namespace eon
 
 
 		// Get substring based on character position and count.
-		// NOTE: This involves counting characters, but will count from the end if closer than start!
-		inline substring substr( index_t start, index_t size ) const {
-			auto sub = substr(); return substring( sub.iterator( start ), sub.iterator( start + size ) ); }
+		// NOTE: This involves counting characters, see [eon::string::charPos] for performance!
+		substring substr( index_t start, index_t size ) const;
 
 
 		// Get a substring (slice) starting at 'start' position and ending at 'end'. If either value is
@@ -935,8 +956,19 @@ namespace eon
 
 		// Get a copy of the entire string with each occurrence of any map 'key' within
 		// 'sub' substring of 'this' replaced by the corresponding map 'value'.
+		// NOTE: Compiles an [eon::multipattern] for each call, use that directly when
+		//       doing the same replacements repeatedly!
 		string replace( const std::map<string, string>& find_replace, const substring& sub ) const;
 
+		// Get a copy of the entire string with each occurrence of any of the
+		// 'patterns' replaced by the corresponding replacement.
+		inline string replace( const multipattern& patterns ) const { return replace( patterns, substr() ); }
+
+		// Get a copy of the entire string with each occurrence of any of the 'patterns'
+		// within 'sub' substring of 'this' replaced by the corresponding replacement.
+		// NOTE: Input is scanned once, and output allocated only once!
+		string replace( const multipattern& patterns, const substring& sub ) const;
+
 		// Get a copy of the entire string with each occurrence of any map
 		// 'key' replaced by the corresponding map 'value'.
 		inline string replace( const std::map<char_t, char_t>& find_replace ) const {
@@ -1413,6 +1445,11 @@ namespace eon
 		inline size_t hash() const noexcept { return substring::hash32( Bytes.c_str(), Bytes.c_str() + Bytes.size() ); }
 #endif
 
+		// Get a 64-bit hash value using the fast hash algorithm.
+		// See [eon::substring::fastHash] for details!
+		inline uint64_t fastHash() const noexcept {
+			return substring::fastHash( Bytes.c_str(), Bytes.c_str() + Bytes.size() ); }
+
 
 
 
@@ -2391,6 +2428,9 @@ namespace eon
 
 		inline bool _ascii() const noexcept { return numBytes() == NumChars; }
 
+		const std::vector<index_t>& _charIndex() const;
+		inline void _dropCharIndex() noexcept { delete CharIndex.exchange( nullptr ); }
+
 
 
 
@@ -2403,8 +2443,17 @@ namespace eon
 		std::string Bytes;
 		index_t NumChars{ 0 };	// Number of code points
 
+		// Byte position of every [CharIndexStep] character, built on demand
+		// by [eon::string::charPos] (for strings of at least
+		// [CharIndexMinBytes] bytes, not pure ASCII) and discarded by all
+		// modifiers.
+		mutable std::atomic<std::vector<index_t>*> CharIndex{ nullptr };
+
 	public:
 		static const string Empty;
+
+		static constexpr index_t CharIndexStep{ 64 };
+		static constexpr index_t CharIndexMinBytes{ 4096 };
 	};
 
 
@@ -2453,10 +2502,11 @@ namespace std
 {
 	// Allow implicit use of [eon::string] as key when used in containers such
 	// as 'std::unordered_map' and 'std::unordered_set'.
+	// NOTE: Uses [eon::string::fastHash], not stable across platforms!
 	template<>
 	struct hash<::eon::string> {
 		inline size_t operator()( const ::eon::string& rhs ) const {
-			return static_cast<size_t>( rhs.hash() ); } };
+			return static_cast<size_t>( rhs.fastHash() ); } };
 
 	// Allow implicit use of [eon::string] as value when used in containers such
 	// as 'std::unordered_map' and 'std::unordered_set'.
@@ -2471,7 +2521,7 @@ namespace std
 	template<>
 	struct hash<::eon::string_ptr> {
 		inline size_t operator()( const ::eon::string_ptr& rhs ) const {
-			return static_cast<size_t>( rhs->hash() ); } };
+			return static_cast<size_t>( rhs->fastHash() ); } };
 
 	// Allow implicit use of [eon::string_ptr] as value when used in containers
 	// such as 'std::unordered_map' and 'std::unordered_set'.
@@ -37,6 +37,7 @@ namespace eon
 	{
 		iterator i( input, input_length );	// Using iterator to scan the raw string for us!
 		_assertValidUtf8( i );
+		_dropCharIndex();
 		NumChars = i.numSourceChars();
 		Bytes.assign( input, input_length );
 		return *this;
@@ -61,6 +62,7 @@ namespace eon
 	{
 		uint32_t bytes;
 		auto size = iterator::unicodeToBytes( input, bytes );
+		_dropCharIndex();
 		Bytes.reserve( size * copies );
 		for( index_t i = 0; i < copies; ++i )
 			Bytes.append( (const char*)&bytes, size );
@@ -82,6 +84,7 @@ namespace eon
 		// Make sure 'other' and 'this' are not the same!
 		if( &other.Bytes != &Bytes )
 		{
+			_dropCharIndex();
 			Bytes.reserve( other.numBytes() * copies );
 			for( index_t i = 0; i < copies; ++i )
 				Bytes.append( other.Bytes );
@@ -103,6 +106,7 @@ namespace eon
 		{
 			iterator i( input );
 			_assertValidUtf8( i );
+			_dropCharIndex();
 			Bytes.reserve( input.size() * copies );
 			for( index_t i = 0; i < copies; ++i )
 				Bytes.append( input );
@@ -181,6 +185,7 @@ namespace eon
 
 	string& string::_assignLowToHigh( const substring& input )
 	{
+		_dropCharIndex();
 		NumChars = input.numChars();
 		Bytes.assign( input.begin().byteData(), input.numBytes() );
 		return *this;
@@ -196,6 +201,7 @@ namespace eon
 	{
 		substring sub( input );
 		_assertValidUtf8( sub );
+		_dropCharIndex();
 		NumChars = sub.numChars();
 		Bytes = std::move( input );
 		return *this;
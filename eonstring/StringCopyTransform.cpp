@@ -1,4 +1,5 @@
 ﻿#include "String.h"
+#include "MultiPattern.h"
 #include <eoninlinetest/InlineTest.h>
 #include <cctype>
 #include <regex>
@@ -123,8 +124,25 @@ namespace eon
 		string obj( "abcde" ),
 		EON_EQ( "dc", string( obj.substr( obj.end() - 2, obj.begin() + 1 ) ) ) );
 
+	substring string::substr( index_t start, index_t size ) const
+	{
+		auto first = charPos( start );
+		return substring( first, size <= CharIndexStep ? first + size : charPos( start + size ) );
+	}
 	EON_TEST( string, substr_indices, basic,
 		EON_EQ( substring( "cde" ), string( "abcde" ).substr( 2, 3 ) ) );
+	EON_TEST_2STEP( string, substr_indices, UTF8,
+		string obj( u8"\u00D8a\u20A0\u0153\u2122" ),
+		EON_EQ( u8"\u20A0\u0153", string( obj.substr( 2, 2 ) ) ) );
+	EON_TEST_2STEP( string, substr_indices, beyond_end,
+		string obj( u8"\u00D8a\u20A0\u0153\u2122" ),
+		EON_EQ( u8"\u0153\u2122", string( obj.substr( 3, 9 ) ) ) );
+	EON_TEST_2STEP( string, substr_indices, indexed,
+		string obj( string( 1000, char_t( 0x20A0 ) ) + string( "abc" ) + string( 1000, char_t( 0x2122 ) ) ),
+		EON_EQ( u8"\u20A0abc\u2122", string( obj.substr( 999, 5 ) ) ) );
+	EON_TEST_2STEP( string, substr_indices, indexed_long,
+		string obj( string( 1000, char_t( 0x20A0 ) ) + string( "abc" ) + string( 1000, char_t( 0x2122 ) ) ),
+		EON_EQ( 1000, obj.substr( 500, 1000 ).numChars() ) );
 
 
 	substring string::slice( int64_t start, int64_t end ) const
@@ -135,8 +153,7 @@ namespace eon
 			++e;
 		else
 			--e;
-		auto sub = substr();
-		return substring( sub.iterator( s ), sub.iterator( e ) );
+		return substring( charPos( s ), charPos( e ) );
 	}
 	EON_TEST( string, slice, empty,
 		EON_EQ( substring(), string().slice( 0, -1 ) ) );
@@ -229,28 +246,9 @@ namespace eon
 
 	string string::replace( const std::map<string, string>& find_replace, const substring& sub ) const
 	{
-		if( sub.empty() )
+		if( sub.empty() || find_replace.empty() )
 			return *this;
-		auto area = sub.lowToHigh();
-		auto output = _prepOutput( area );
-		for( iterator i = area.begin(); i != area.end(); ++i )
-		{
-			for( auto& elm : find_replace )
-			{
-				if( substr( i, area.end() ).compareSub( elm.first.substr(), elm.first.numChars() ) == 0 )
-				{
-					output += elm.second;
-					i += elm.first.numChars() - 1;
-					goto done;
-				}
-			}
-			output += *i;
-		done:
-			;
-		}
-		if( area.end() != end() )
-			output += substr( area.end(), end() );
-		return output;
+		return replace( multipattern( find_replace ), sub );
 	}
 	EON_TEST( string, replace, str_map_empty,
 		EON_EQ( "", string().replace( std::map<string, string>() ) ) );
@@ -271,6 +269,54 @@ namespace eon
 		EON_EQ( "abcddcefabgh", obj.replace( std::map<string, string>EON_CURLY( EON_CURLY( "ab", "dc" ) ), obj.substr(
 			obj.begin() + 3, obj.end() - 3 ) ) ) );
 
+	EON_TEST( string, replace, str_map_overlapping,
+		EON_EQ( "1d1ef", string( "abcdabcef" ).replace( std::map<string, string>EON_CURLY(
+			EON_CURLY( "abc", "1" ), EON_CURLY( "bce", "x" ), EON_CURLY( "abce", "2" ) ) ) ) );
+
+	string string::replace( const multipattern& patterns, const substring& sub ) const
+	{
+		if( sub.empty() || patterns.empty() )
+			return *this;
+		auto area = sub.lowToHigh();
+
+		// Locate all matches first, so we know the exact size of the output
+		std::vector<std::pair<const char*, index_t>> found;
+		index_t num_bytes = Bytes.size(), num_chars = NumChars, pattern_no = 0;
+		for( auto pos = area.begin().byteData(), end = area.end().byteData(); ; )
+		{
+			pos = patterns.findFirst( pos, end, pattern_no );
+			if( pos == nullptr )
+				break;
+			found.push_back( std::make_pair( pos, pattern_no ) );
+			auto& pattern = patterns.pattern( pattern_no );
+			auto& replacement = patterns.replacement( pattern_no );
+			num_bytes = num_bytes - pattern.numBytes() + replacement.numBytes();
+			num_chars = num_chars - pattern.numChars() + replacement.numChars();
+			pos += pattern.numBytes();
+		}
+		if( found.empty() )
+			return *this;
+
+		string output;
+		output.Bytes.reserve( num_bytes );
+		auto copied = Bytes.c_str();
+		for( auto& match : found )
+		{
+			output.Bytes.append( copied, match.first - copied );
+			output.Bytes += patterns.replacement( match.second ).Bytes;
+			copied = match.first + patterns.pattern( match.second ).numBytes();
+		}
+		output.Bytes.append( copied, ( Bytes.c_str() + Bytes.size() ) - copied );
+		output.NumChars = num_chars;
+		return output;
+	}
+	EON_TEST_2STEP( string, replace, multipattern,
+		multipattern patterns( std::map<string, string>EON_CURLY( EON_CURLY( "ab", "dc" ), EON_CURLY( "ef", "ta" ) ) ),
+		EON_EQ( "dccddctadcgh", string( "abcdabefabgh" ).replace( patterns ) ) );
+	EON_TEST_2STEP( string, replace, multipattern_UTF8,
+		multipattern patterns( std::map<string, string>EON_CURLY( EON_CURLY( u8"\u00D8", "o" ) ) ),
+		EON_EQ( 5, string( u8"a\u00D8b\u00D8c" ).replace( patterns ).numChars() ) );
+
 	string string::replace( const std::map<char_t, char_t>& find_replace, const substring& sub ) const
 	{
 		if( sub.empty() )
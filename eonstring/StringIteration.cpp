@@ -45,6 +45,71 @@ namespace eon
 		string obj( EON_CURLY( char_t( 913 ), char_t( 914 ), char_t( 915 ), char_t( 916 ) ) ),
 		EON_EQ( 915, static_cast<int>( *obj.bytePos( 3 ) ) ) );
 
+	string::iterator string::charPos( index_t pos ) const
+	{
+		if( pos >= NumChars )
+			return end();
+		if( _ascii() )
+			return iterator( Bytes.c_str(), Bytes.size(), NumChars, Bytes.c_str() + pos, pos );
+		if( Bytes.size() < CharIndexMinBytes )
+			return substr().iterator( pos );
+
+		// Jump to the closest indexed position before 'pos' and count from there
+		auto& index = _charIndex();
+		auto indexed = pos / CharIndexStep;
+		return iterator( Bytes.c_str(), Bytes.size(), NumChars, Bytes.c_str() + index[ indexed ],
+			indexed * CharIndexStep ) += pos % CharIndexStep;
+	}
+	EON_TEST_2STEP( string, charPos, ASCII,
+		string obj( "abcdef" ),
+		EON_EQ( "3:3", obj.charPos( 3 ).encode() ) );
+	EON_TEST_2STEP( string, charPos, UTF8,
+		string obj( u8"\u00D8a\u20A0\u0153\u2122" ),
+		EON_EQ( "6:3", obj.charPos( 3 ).encode() ) );
+	EON_TEST_2STEP( string, charPos, beyond_end,
+		string obj( u8"\u00D8a\u20A0\u0153\u2122" ),
+		EON_EQ( obj.end(), obj.charPos( 5 ) ) );
+	EON_TEST_2STEP( string, charPos, indexed,
+		string obj( string( 2000, char_t( 0x20A0 ) ) + string( "abc" ) ),
+		EON_EQ( "6001:2001", obj.charPos( 2001 ).encode() ) );
+	EON_TEST_3STEP( string, charPos, modified,
+		string obj( string( 3000, char_t( 0x20A0 ) ) + string( "abc" ) ),
+		obj.charPos( 1 ); obj.erase( obj.substr( obj.begin(), obj.begin() + 1000 ) ),
+		EON_EQ( char_t( 'b' ), *obj.charPos( 2001 ) ) );
+
+	EON_TEST_2STEP( string, at, UTF8,
+		string obj( u8"\u00D8a\u20A0\u0153\u2122" ),
+		EON_EQ( char_t( 0x0153 ), obj.at( 3 ) ) );
+	EON_TEST_2STEP( string, at, beyond_end,
+		string obj( "abc" ),
+		EON_EQ( nochar, obj.at( 3 ) ) );
+
+	const std::vector<index_t>& string::_charIndex() const
+	{
+		auto index = CharIndex.load( std::memory_order_acquire );
+		if( index != nullptr )
+			return *index;
+
+		auto built = new std::vector<index_t>();
+		built->reserve( NumChars / CharIndexStep + 1 );
+		for( auto i = begin(); i; i += CharIndexStep )
+			built->push_back( i.numByte() );
+
+		// Another thread may have beaten us to it, in which case we use theirs
+		if( CharIndex.compare_exchange_strong( index, built, std::memory_order_acq_rel ) )
+			return *built;
+		delete built;
+		return *index;
+	}
+	EON_TEST_3STEP( string, _charIndex, basic,
+		string obj( string( 130, char_t( 0x20A0 ) ) ),
+		auto& index = obj._charIndex(),
+		EON_TRUE( index.size() == 3 && index[ 1 ] == 192 && index[ 2 ] == 384 ) );
+	EON_TEST_3STEP( string, _charIndex, copy,
+		string obj( string( 2000, char_t( 0x20A0 ) ) ),
+		obj.charPos( 1 ); string copy( obj ),
+		EON_TRUE( obj.CharIndex.load() != nullptr && copy.CharIndex.load() == nullptr ) );
+
 	inline string::iterator string::_ensureValidStart( iterator& start ) const
 	{
 		if( start )
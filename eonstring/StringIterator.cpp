@@ -3,6 +3,16 @@
 #include <eoninlinetest/InlineTest.h>
 #include <cctype>
 #include <regex>
+#if defined( __x86_64__ ) || defined( _M_X64 )
+#	define EON_UTF8_SIMD
+#	include <immintrin.h>
+#	ifdef _MSC_VER
+#		include <intrin.h>
+#		define EON_AVX2
+#	else
+#		define EON_AVX2 __attribute__(( target( "avx2,popcnt" ) ))
+#	endif
+#endif
 
 
 namespace eon
@@ -509,6 +519,15 @@ namespace eon
 	EON_TEST_2STEP( string_iterator, operator_plusasgn, UTF8_three,
 		string_iterator obj( u8"\u00D8\u20A0\u0153\u2122\u00A9\u00B5" ),
 		EON_EQ( char_t( 8482 ), *( obj += static_cast<index_t>( 3 ) ) ) );
+	EON_TEST_2STEP( string_iterator, operator_plusasgn, UTF8_long,
+		string_iterator obj( u8"\u00D8abcdefghijklmno\u20A0pqrstuvwxyz\u0153\u2122\u00A9\u00B5" ),
+		EON_EQ( "31:28", ( obj += static_cast<index_t>( 28 ) ).encode() ) );
+	EON_TEST_2STEP( string_iterator, operator_plusasgn, UTF8_to_end,
+		string_iterator obj( u8"\u00D8abcdefghijklmno\u20A0pqrstuvwxyz\u0153\u2122" ),
+		EON_TRUE( ( obj += static_cast<index_t>( 30 ) ).atEnd() ) );
+	EON_TEST_2STEP( string_iterator, operator_plusasgn, UTF8_beyond_end,
+		string_iterator obj( u8"\u00D8abcdefghijklmno\u20A0pqrstuvwxyz\u0153\u2122" ),
+		EON_TRUE( ( obj += static_cast<index_t>( 40 ) ).atEnd() ) );
 
 	string_iterator& string_iterator::operator-=( index_t num_chars ) noexcept
 	{
@@ -789,14 +808,8 @@ namespace eon
 
 	index_t string_iterator::countUtf8Chars( const char* str, index_t size )
 	{
-		char32_t cp{ 0 }, state{ 0 };
 		index_t num = 0;
-		for( auto c = str, end_c = str + size; c != end_c; ++c )
-		{
-			if( !_utf8Decode( state, cp, static_cast<unsigned char>( *c ) ) )
-				++num;
-		}
-		if( state != UTF8_ACCEPT )
+		if( !scanUtf8( str, str + size, num ) )
 			throw InvalidUTF8( "Not a valid UTF-8 string value" );
 		return num;
 	}
@@ -809,6 +822,232 @@ namespace eon
 
 
 
+	// Scalar UTF-8 scanner, skips ASCII 8 bytes at a time.
+	static bool _scanUtf8Scalar( const char* c, const char* end, index_t& num_chars ) noexcept
+	{
+		char32_t state{ UTF8_ACCEPT }, cp{ 0 };
+		index_t num = 0;
+		while( c != end )
+		{
+			if( state == UTF8_ACCEPT )
+			{
+				for( uint64_t word = 0; end - c >= 8; c += 8, num += 8 )
+				{
+					memcpy( &word, c, 8 );
+					if( word & 0x8080808080808080ull )
+						break;
+				}
+				if( c == end )
+					break;
+			}
+			if( !_utf8Decode( state, cp, static_cast<unsigned char>( *c++ ) ) )
+				++num;
+			else if( state == UTF8_REJECT )
+				return false;
+		}
+		num_chars = num;
+		return state == UTF8_ACCEPT;
+	}
+	EON_TEST_3STEP( string_iterator, _scanUtf8Scalar, mixed,
+		const char* source = u8"abcdefghijklmnop\u00D8\u20A0\u0153\u2122\u00A9\u00B5qrstuvwxyz",
+		index_t num = 0,
+		EON_TRUE( _scanUtf8Scalar( source, source + strlen( source ), num ) && num == 32 ) );
+	EON_TEST_3STEP( string_iterator, _scanUtf8Scalar, invalid,
+		auto source = eonitest::PrimitiveArray<char>( EON_CURLY( 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', char( 197 ), 'e' ) ),
+		index_t num = 0,
+		EON_FALSE( _scanUtf8Scalar( source.value(), source.value() + 10, num ) ) );
+
+#ifdef EON_UTF8_SIMD
+	// SSE2 UTF-8 scanner, skips ASCII 16 bytes at a time.
+	// (SSE2 lacks the byte shuffle needed for vectorized validation of
+	// multi-byte characters, those are decoded one byte at a time.)
+	static bool _scanUtf8Sse2( const char* c, const char* end, index_t& num_chars ) noexcept
+	{
+		char32_t state{ UTF8_ACCEPT }, cp{ 0 };
+		index_t num = 0;
+		while( c != end )
+		{
+			if( state == UTF8_ACCEPT )
+			{
+				for( ; end - c >= 16; c += 16, num += 16 )
+				{
+					if( _mm_movemask_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i*>( c ) ) ) != 0 )
+						break;
+				}
+				if( c == end )
+					break;
+			}
+			if( !_utf8Decode( state, cp, static_cast<unsigned char>( *c++ ) ) )
+				++num;
+			else if( state == UTF8_REJECT )
+				return false;
+		}
+		num_chars = num;
+		return state == UTF8_ACCEPT;
+	}
+	EON_TEST_3STEP( string_iterator, _scanUtf8Sse2, mixed,
+		const char* source = u8"abcdefghijklmnop\u00D8\u20A0\u0153\u2122\u00A9\u00B5qrstuvwxyz",
+		index_t num = 0,
+		EON_TRUE( _scanUtf8Sse2( source, source + strlen( source ), num ) && num == 32 ) );
+
+
+	// AVX2 UTF-8 validation, based on the lookup algorithm by Keiser and
+	// Lemire ("Validating UTF-8 In Less Than One Instruction Per Byte",
+	// 2020). Each byte is classified using its own high nibble and the high
+	// and low nibbles of the preceding byte, the three 16-entry lookups are
+	// combined and must come out zero except where a 3rd or 4th byte of a
+	// sequence is expected.
+	// Characters are counted as the number of bytes that are not
+	// continuation bytes.
+	static const uint8_t TooShort{ 1 << 0 }, TooLong{ 1 << 1 }, Overlong3{ 1 << 2 }, TooLarge{ 1 << 3 },
+		Surrogate{ 1 << 4 }, Overlong2{ 1 << 5 }, TooLarge1000{ 1 << 6 }, Overlong4{ 1 << 6 }, TwoConts{ 1 << 7 },
+		Carry{ TooShort | TooLong | TwoConts };
+
+	template<int N>
+	EON_AVX2 inline __m256i _avx2Prev( __m256i input, __m256i prev_input ) noexcept {
+		return _mm256_alignr_epi8( input, _mm256_permute2x128_si256( prev_input, input, 0x21 ), 16 - N ); }
+
+	EON_AVX2 inline __m256i _avx2Lookup( __m256i nibbles, const uint8_t( &table )[ 16 ] ) noexcept {
+		return _mm256_shuffle_epi8( _mm256_broadcastsi128_si256(
+			_mm_loadu_si128( reinterpret_cast<const __m128i*>( table ) ) ), nibbles ); }
+
+	EON_AVX2 inline void _avx2Utf8Block(
+		__m256i input, __m256i& prev_input, __m256i& prev_incomplete, __m256i& error, index_t& num ) noexcept
+	{
+		static const uint8_t byte_1_high[ 16 ]{
+			TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong,
+			TwoConts, TwoConts, TwoConts, TwoConts,
+			TooShort | Overlong2,
+			TooShort,
+			TooShort | Overlong3 | Surrogate,
+			TooShort | TooLarge | TooLarge1000 | Overlong4 };
+		static const uint8_t byte_1_low[ 16 ]{
+			Carry | Overlong3 | Overlong2 | Overlong4,
+			Carry | Overlong2,
+			Carry, Carry,
+			Carry | TooLarge,
+			Carry | TooLarge | TooLarge1000, Carry | TooLarge | TooLarge1000, Carry | TooLarge | TooLarge1000,
+			Carry | TooLarge | TooLarge1000, Carry | TooLarge | TooLarge1000, Carry | TooLarge | TooLarge1000,
+			Carry | TooLarge | TooLarge1000, Carry | TooLarge | TooLarge1000,
+			Carry | TooLarge | TooLarge1000 | Surrogate,
+			Carry | TooLarge | TooLarge1000, Carry | TooLarge | TooLarge1000 };
+		static const uint8_t byte_2_high[ 16 ]{
+			TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort,
+			TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge1000 | Overlong4,
+			TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge,
+			TooLong | Overlong2 | TwoConts | Surrogate | TooLarge,
+			TooLong | Overlong2 | TwoConts | Surrogate | TooLarge,
+			TooShort, TooShort, TooShort, TooShort };
+
+		// Count all bytes that are not continuation bytes (0x80-0xBF)
+		num += static_cast<index_t>( _mm_popcnt_u32( static_cast<unsigned int>(
+			_mm256_movemask_epi8( _mm256_cmpgt_epi8( input, _mm256_set1_epi8( -65 ) ) ) ) ) );
+
+		if( _mm256_movemask_epi8( input ) == 0 )
+		{
+			// All ASCII, only need to check that the previous block did not
+			// end in the middle of a character.
+			error = _mm256_or_si256( error, prev_incomplete );
+			prev_incomplete = _mm256_setzero_si256();
+			prev_input = input;
+			return;
+		}
+
+		const auto low_nibble = _mm256_set1_epi8( 0x0F );
+		auto prev1 = _avx2Prev<1>( input, prev_input );
+		auto special = _mm256_and_si256(
+			_mm256_and_si256(
+				_avx2Lookup( _mm256_and_si256( _mm256_srli_epi16( prev1, 4 ), low_nibble ), byte_1_high ),
+				_avx2Lookup( _mm256_and_si256( prev1, low_nibble ), byte_1_low ) ),
+			_avx2Lookup( _mm256_and_si256( _mm256_srli_epi16( input, 4 ), low_nibble ), byte_2_high ) );
+
+		// Bytes that must be the 3rd or 4th of a sequence
+		auto third = _mm256_subs_epu8( _avx2Prev<2>( input, prev_input ), _mm256_set1_epi8( char( 0xE0 - 0x80 ) ) );
+		auto fourth = _mm256_subs_epu8( _avx2Prev<3>( input, prev_input ), _mm256_set1_epi8( char( 0xF0 - 0x80 ) ) );
+		auto must_23 = _mm256_and_si256( _mm256_or_si256( third, fourth ), _mm256_set1_epi8( char( 0x80 ) ) );
+		error = _mm256_or_si256( error, _mm256_xor_si256( must_23, special ) );
+
+		// Does this block end in the middle of a character?
+		static const uint8_t max_value[ 32 ]{
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+			255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1 };
+		prev_incomplete = _mm256_subs_epu8(
+			input, _mm256_loadu_si256( reinterpret_cast<const __m256i*>( max_value ) ) );
+		prev_input = input;
+	}
+
+	EON_AVX2 static bool _scanUtf8Avx2( const char* c, const char* end, index_t& num_chars ) noexcept
+	{
+		auto prev_input = _mm256_setzero_si256(), prev_incomplete = _mm256_setzero_si256();
+		auto error = _mm256_setzero_si256();
+		index_t num = 0;
+		for( ; end - c >= 32; c += 32 )
+			_avx2Utf8Block( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( c ) ),
+				prev_input, prev_incomplete, error, num );
+		if( c != end )
+		{
+			// Pad the remainder with zeros (ASCII) and don't count those
+			alignas( 32 ) char tail[ 32 ]{};
+			memcpy( tail, c, end - c );
+			_avx2Utf8Block( _mm256_load_si256( reinterpret_cast<const __m256i*>( tail ) ),
+				prev_input, prev_incomplete, error, num );
+			num -= 32 - ( end - c );
+		}
+		else
+			error = _mm256_or_si256( error, prev_incomplete );
+		num_chars = num;
+		return _mm256_testz_si256( error, error ) != 0;
+	}
+
+	static bool _haveAvx2() noexcept
+	{
+#ifdef _MSC_VER
+		int info[ 4 ];
+		__cpuid( info, 1 );
+		if( ( info[ 2 ] & ( 1 << 27 ) ) == 0 || ( _xgetbv( 0 ) & 6 ) != 6 )
+			return false;
+		__cpuidex( info, 7, 0 );
+		return ( info[ 1 ] & ( 1 << 5 ) ) != 0;
+#else
+		return __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "popcnt" );
+#endif
+	}
+#endif
+
+	bool string_iterator::scanUtf8( const char* begin, const char* end, index_t& num_chars ) noexcept
+	{
+		// Short strings are not worth the vector setup
+		if( end - begin < 32 )
+			return _scanUtf8Scalar( begin, end, num_chars );
+#ifdef EON_UTF8_SIMD
+		static const bool avx2 = _haveAvx2();
+		return avx2 ? _scanUtf8Avx2( begin, end, num_chars ) : _scanUtf8Sse2( begin, end, num_chars );
+#else
+		return _scanUtf8Scalar( begin, end, num_chars );
+#endif
+	}
+	EON_TEST_3STEP( string_iterator, scanUtf8, ASCII,
+		const char* source = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+		index_t num = 0,
+		EON_TRUE( string_iterator::scanUtf8( source, source + 62, num ) && num == 62 ) );
+	EON_TEST_3STEP( string_iterator, scanUtf8, UTF8,
+		const char* source = u8"\u00D8\u20A0\u0153\u2122\u00A9\u00B5abcdefghijklmnopqrstuvwxyz\U0001F600\u00D8\u20A0\u0153\u2122\u00A9\u00B5",
+		index_t num = 0,
+		EON_TRUE( string_iterator::scanUtf8( source, source + strlen( source ), num ) && num == 39 ) );
+	EON_TEST_3STEP( string_iterator, scanUtf8, truncated,
+		const char* source = u8"abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ\u2122",
+		index_t num = 0,
+		EON_FALSE( string_iterator::scanUtf8( source, source + 64, num ) ) );
+	EON_TEST_3STEP( string_iterator, scanUtf8, surrogate,
+		auto source = eonitest::PrimitiveArray<char>( EON_CURLY(
+			'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p',
+			'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p',
+			char( 0xED ), char( 0xA0 ), char( 0x80 ), 'x' ) ),
+		index_t num = 0,
+		EON_FALSE( string_iterator::scanUtf8( source.value(), source.value() + 36, num ) ) );
+
+
+
 	void string_iterator::_prep( const char* begin, const char* end, const char* pos ) noexcept
 	{
 		Source = begin; SourceEnd = end; Pos = pos;
@@ -821,24 +1060,16 @@ namespace eon
 
 	void string_iterator::_utf8CharacterCount() noexcept
 	{
-		char32_t state = 0, cp = 0;
-		const char* cs{ nullptr };
-		NumSourceChars = 0;
-		for( auto c = Source; c != SourceEnd; ++c )
-		{
-			if( cs == nullptr )
-				cs = c;
-			if( !_utf8Decode( state, cp, static_cast<unsigned char>( *c ) ) )
-			{
-				if( cs == Pos )
-					NumChar = NumSourceChars;
-				++NumSourceChars;
-				cs = nullptr;
-			}
-		}
-		ValidUTF8 = state == UTF8_ACCEPT;
+		ValidUTF8 = scanUtf8( Source, SourceEnd, NumSourceChars );
 		if( !ValidUTF8 )
+		{
 			NumSourceChars = SourceEnd - Source;
+			NumChar = Pos - Source;
+		}
+		else if( Pos == SourceEnd )
+			NumChar = NumSourceChars;
+		else if( Pos > Source && ( static_cast<unsigned char>( *Pos ) & 0xC0 ) != 0x80 )
+			scanUtf8( Source, Pos, NumChar );
 	}
 	EON_NO_TEST( string_iterator, _utf8CharacterCount );
 
@@ -904,4 +1135,38 @@ namespace eon
 		}
 	}
 	EON_NO_TEST( string_iterator, _advanceBytes );
+
+	void string_iterator::_advanceChars( index_t num_chars ) noexcept
+	{
+		if( num_chars == 0 || Pos == SourceEnd )
+			return;
+
+		// Every byte that is not a continuation byte (10xxxxxx) starts a
+		// character, so we only have to count those until we have passed
+		// 'num_chars' of them. Whole words are counted while we need more
+		// than there can be in them.
+		auto c = Pos + 1;
+		auto remaining = num_chars;
+		for( uint64_t word = 0; remaining > 8 && SourceEnd - c >= 8; c += 8 )
+		{
+			memcpy( &word, c, 8 );
+			auto continuation = word & ~( word << 1 ) & 0x8080808080808080ull;
+			remaining -= 8 - static_cast<index_t>( ( ( continuation >> 7 ) * 0x0101010101010101ull ) >> 56 );
+		}
+		for( ; c != SourceEnd; ++c )
+		{
+			if( ( static_cast<unsigned char>( *c ) & 0xC0 ) != 0x80 && --remaining == 0 )
+				break;
+		}
+		if( c == SourceEnd )
+		{
+			resetToEnd();
+			return;
+		}
+		Pos = c;
+		NumChar += num_chars;
+		_translateCodepoint();
+	}
+	EON_NO_TEST( string_iterator, _advanceChars );
+
 }
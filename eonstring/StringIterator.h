@@ -364,11 +364,13 @@ namespace eon
 
 
 		// Move forward a specific number of (UTF-8) characters.
-		// Uses the prefix increment operator.
-		// Optimized for pure ASCII strings!
+		// Optimized for pure ASCII strings, and for valid UTF-8 strings where
+		// only the lead bytes are counted (8 bytes at a time) and only the
+		// final character is decoded!
 		inline string_iterator& operator+=( index_t num_chars ) noexcept {
 			if( bytesOnly() ) _advanceBytes( num_chars );
-				else { for( index_t i = 0; i < num_chars && *this; ++i, ++*this ); } return *this; }
+			else if( ValidUTF8 && !atREnd() ) _advanceChars( num_chars );
+			else { for( index_t i = 0; i < num_chars && *this; ++i, ++*this ); } return *this; }
 
 		// Move backward a specific number of characaters.
 		// Uses the prefix decrement operator.
@@ -491,6 +493,14 @@ namespace eon
 		// Throws [eon::InvalidUTF8] if not valid!
 		static index_t countUtf8Chars( const char* str, index_t size );
 
+		// Validate the raw byte string from 'begin' to 'end' as UTF-8 and
+		// count the number of characters in it, in a single pass.
+		// Uses AVX2 or SSE2 if supported by the host (detected at run-time),
+		// ASCII-only blocks are skipped without decoding.
+		// Returns true and sets 'num_chars' if valid UTF-8, false if not (in
+		// which case 'num_chars' is undefined).
+		static bool scanUtf8( const char* begin, const char* end, index_t& num_chars ) noexcept;
+
 
 
 
@@ -510,6 +520,8 @@ namespace eon
 
 		void _advanceBytes( index_t bytes ) noexcept;
 
+		void _advanceChars( index_t num_chars ) noexcept;
+
 
 
 
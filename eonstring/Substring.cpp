@@ -1,6 +1,10 @@
 ﻿#include "Substring.h"
 #include <eoninlinetest/InlineTest.h>
 #include <cctype>
+#include <cstring>
+#if defined( _MSC_VER ) && defined( _M_X64 )
+#	include <intrin.h>
+#endif
 
 
 namespace eon
@@ -160,19 +164,69 @@ namespace eon
 
 	substring substring::_optimizedFindFirst( const substring& to_find ) const noexcept
 	{
-		// If the sub-string isn't bytes-only, we know it cannot exist within the source!
-		if( !to_find.begin().bytesOnly() )
-			return substring( End.getEnd() );
-
+		// UTF-8 is self-synchronizing, a byte-level match of valid UTF-8 will
+		// always start and end on character boundaries.
 		auto found = _findFirst( Beg.Pos, numBytes(), to_find.begin().Pos, to_find.numBytes() );
 		if( found != nullptr )
-		{
-			return substring( string_iterator( Beg, found, found - Beg.Source ),
-				string_iterator( Beg, found + to_find.numBytes(), ( found + to_find.numBytes() ) - Beg.Source ) );
-		}
+			return _foundBytes( found, to_find.numBytes(), to_find.numChars() );
 		else
 			return substring( End.getEnd() );
 	}
+	EON_TEST_2STEP( substring, findFirst, UTF8_substring,
+		string obj( u8"\u00D8a\u20A0\u0153\u2122" ),
+		EON_EQ( "3:2", obj.substr().findFirst( string( u8"\u20A0\u0153" ).substr() ).begin().encode() ) );
+	EON_TEST_2STEP( substring, findFirst, UTF8_substring_end,
+		string obj( u8"\u00D8a\u20A0\u0153\u2122" ),
+		EON_EQ( "11:5", obj.substr().findFirst( string( u8"\u20A0\u0153\u2122" ).substr() ).end().encode() ) );
+	EON_TEST_2STEP( substring, findFirst, UTF8_substring_none,
+		string obj( u8"\u00D8a\u20A0\u0153\u2122" ),
+		EON_FALSE( obj.substr().findFirst( string( u8"\u20A0\u2122" ).substr() ) ) );
+	EON_TEST_2STEP( substring, findFirst, ASCII_in_UTF8,
+		string obj( u8"\u00D8ab" ),
+		EON_EQ( "2:1", obj.substr().findFirst( string( "ab" ).substr() ).begin().encode() ) );
+	EON_TEST_2STEP( substring, findFirst, long_source,
+		string obj( std::string( 300, 'a' ) + "abcde" + std::string( 20, 'b' ) ),
+		EON_EQ( obj.substr( 300, 5 ), obj.substr().findFirst( string( "abcde" ).substr() ) ) );
+	EON_TEST_2STEP( substring, findFirst, long_source_at_end,
+		string obj( std::string( 300, 'x' ) + "wxyz" ),
+		EON_EQ( obj.substr( 300, 4 ), obj.substr().findFirst( string( "wxyz" ).substr() ) ) );
+	EON_TEST_2STEP( substring, findFirst, long_source_none,
+		string obj( std::string( 300, 'a' ) + "abcd" ),
+		EON_FALSE( obj.substr().findFirst( string( "abce" ).substr() ) ) );
+
+	substring substring::_optimizedFindFirst( const substring& to_find, const char* ascii_fold ) const noexcept
+	{
+		auto found = _findFirst( Beg.Pos, numBytes(), to_find.begin().Pos, to_find.numBytes(), ascii_fold );
+		if( found != nullptr )
+			return _foundBytes( found, to_find.numBytes(), to_find.numChars() );
+		else
+			return substring( End.getEnd() );
+	}
+	EON_TEST_2STEP( substring, findFirst, icase_short,
+		string obj( "abCdef" ),
+		EON_EQ( obj.substr( 2, 2 ), obj.substr().findFirst( string( "cD" ).substr(), substring::ICaseChrCompare ) ) );
+	EON_TEST_2STEP( substring, findFirst, icase_long,
+		string obj( "The Quick Brown Fox" ),
+		EON_EQ( obj.substr( 4, 11 ),
+			obj.substr().findFirst( string( "QUICK BROWN" ).substr(), substring::ICaseChrCompare ) ) );
+	EON_TEST_2STEP( substring, findFirst, icase_none,
+		string obj( "The Quick Brown Fox" ),
+		EON_FALSE( obj.substr().findFirst( string( "quick fox" ).substr(), substring::ICaseChrCompare ) ) );
+
+	substring substring::_foundBytes( const char* found, index_t num_bytes, index_t num_chars ) const noexcept
+	{
+		index_t num_char = 0;
+		if( Beg.bytesOnly() )
+			num_char = found - Beg.Source;
+		else
+		{
+			// Only count the characters skipped, and only once
+			string_iterator::scanUtf8( Beg.Pos, found, num_char );
+			num_char += Beg.NumChar;
+		}
+		return substring( string_iterator( Beg, found, num_char ),
+			string_iterator( Beg, found + num_bytes, num_char + num_chars ) );
+	}
 
 	substring substring::_optimizedFindFirst( char_t to_find ) const noexcept
 	{
@@ -255,10 +309,16 @@ namespace eon
 	}
 
 	const char* substring::_findFirst( const char* source, index_t source_size,
-		const char* substr, index_t substr_size ) const noexcept
+		const char* substr, index_t substr_size ) noexcept
 	{
 		if( substr_size > source_size )
 			return nullptr;
+
+		// The skip table costs more than it saves for short needles and sources,
+		// where the memchr-driven scan below is faster.
+		if( substr_size >= 4 && source_size >= 256 )
+			return _findFirstHorspool( source, source_size, substr, substr_size );
+
 		const char* end = source + source_size - ( substr_size - 1 );
 		for( auto c = _findFirst( source, end - source, *substr );
 			c != nullptr && c != end;
@@ -269,6 +329,64 @@ namespace eon
 		}
 		return nullptr;
 	}
+	const char* substring::_findFirstHorspool( const char* source, index_t source_size,
+		const char* substr, index_t substr_size ) noexcept
+	{
+		// Boyer-Moore-Horspool: When the last byte of the window doesn't
+		// complete a match, skip ahead to align it with its last occurrence
+		// in the needle (or skip the entire needle if it doesn't occur).
+		index_t skip[ 256 ];
+		for( auto& s : skip )
+			s = substr_size;
+		auto last = substr_size - 1;
+		for( index_t i = 0; i < last; ++i )
+			skip[ static_cast<byte_t>( substr[ i ] ) ] = last - i;
+
+		auto last_byte = substr[ last ];
+		const char* end = source + source_size - last;
+		for( auto c = source; c < end; )
+		{
+			auto byte = c[ last ];
+			if( byte == last_byte && memcmp( c, substr, last ) == 0 )
+				return c;
+			c += skip[ static_cast<byte_t>( byte ) ];
+		}
+		return nullptr;
+	}
+
+	const char* substring::_findFirst( const char* source, index_t source_size,
+		const char* substr, index_t substr_size, const char* ascii_fold ) noexcept
+	{
+		if( substr_size > source_size )
+			return nullptr;
+
+		// Same as [_findFirstHorspool], but on case folded bytes
+		auto fold = [ascii_fold]( char c ) -> byte_t { return static_cast<byte_t>( ascii_fold[ c & 0x7F ] ); };
+		index_t skip[ 128 ];
+		for( auto& s : skip )
+			s = substr_size;
+		auto last = substr_size - 1;
+		for( index_t i = 0; i < last; ++i )
+			skip[ fold( substr[ i ] ) ] = last - i;
+
+		auto last_byte = fold( substr[ last ] );
+		const char* end = source + source_size - last;
+		for( auto c = source; c < end; )
+		{
+			auto byte = fold( c[ last ] );
+			if( byte == last_byte )
+			{
+				index_t i = 0;
+				for( ; i < last && fold( c[ i ] ) == fold( substr[ i ] ); ++i )
+					;
+				if( i == last )
+					return c;
+			}
+			c += skip[ byte ];
+		}
+		return nullptr;
+	}
+
 	const char* substring::_findLast( const char* str, index_t str_size, char chr ) noexcept
 	{
 		for( auto c = str, end = str - str_size; c != end; --c )
@@ -306,4 +424,94 @@ namespace eon
 		}
 		return revs;
 	}
+
+
+
+	static const uint64_t WySecret[ 4 ]{
+		0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull };
+	inline void _wyMultiply( uint64_t& a, uint64_t& b ) noexcept
+	{
+#if defined( __SIZEOF_INT128__ )
+		__uint128_t r = a;
+		r *= b;
+		a = static_cast<uint64_t>( r );
+		b = static_cast<uint64_t>( r >> 64 );
+#elif defined( _MSC_VER ) && defined( _M_X64 )
+		a = _umul128( a, b, &b );
+#else
+		uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>( a ), lb = static_cast<uint32_t>( b );
+		uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+		uint64_t t = rl + ( rm0 << 32 ), c = t < rl;
+		uint64_t lo = t + ( rm1 << 32 );
+		c += lo < t;
+		a = lo;
+		b = rh + ( rm0 >> 32 ) + ( rm1 >> 32 ) + c;
+#endif
+	}
+	inline uint64_t _wyMix( uint64_t a, uint64_t b ) noexcept { _wyMultiply( a, b ); return a ^ b; }
+	inline uint64_t _wyRead8( const char* p ) noexcept { uint64_t v; memcpy( &v, p, 8 ); return v; }
+	inline uint64_t _wyRead4( const char* p ) noexcept { uint32_t v; memcpy( &v, p, 4 ); return v; }
+	inline uint64_t _wyRead3( const char* p, size_t k ) noexcept {
+		return ( static_cast<uint64_t>( static_cast<byte_t>( p[ 0 ] ) ) << 16 )
+			| ( static_cast<uint64_t>( static_cast<byte_t>( p[ k >> 1 ] ) ) << 8 )
+			| static_cast<byte_t>( p[ k - 1 ] ); }
+
+	uint64_t substring::fastHash( const char* begin, const char* end, uint64_t seed ) noexcept
+	{
+		auto p = begin;
+		size_t len = static_cast<size_t>( end - begin );
+		seed ^= _wyMix( seed ^ WySecret[ 0 ], WySecret[ 1 ] );
+		uint64_t a{ 0 }, b{ 0 };
+		if( len <= 16 )
+		{
+			if( len >= 4 )
+			{
+				a = ( _wyRead4( p ) << 32 ) | _wyRead4( p + ( ( len >> 3 ) << 2 ) );
+				b = ( _wyRead4( p + len - 4 ) << 32 ) | _wyRead4( p + len - 4 - ( ( len >> 3 ) << 2 ) );
+			}
+			else if( len > 0 )
+				a = _wyRead3( p, len );
+		}
+		else
+		{
+			auto i = len;
+			if( i > 48 )
+			{
+				uint64_t seed1 = seed, seed2 = seed;
+				do
+				{
+					seed = _wyMix( _wyRead8( p ) ^ WySecret[ 1 ], _wyRead8( p + 8 ) ^ seed );
+					seed1 = _wyMix( _wyRead8( p + 16 ) ^ WySecret[ 2 ], _wyRead8( p + 24 ) ^ seed1 );
+					seed2 = _wyMix( _wyRead8( p + 32 ) ^ WySecret[ 3 ], _wyRead8( p + 40 ) ^ seed2 );
+					p += 48;
+					i -= 48;
+				} while( i > 48 );
+				seed ^= seed1 ^ seed2;
+			}
+			while( i > 16 )
+			{
+				seed = _wyMix( _wyRead8( p ) ^ WySecret[ 1 ], _wyRead8( p + 8 ) ^ seed );
+				i -= 16;
+				p += 16;
+			}
+			a = _wyRead8( p + i - 16 );
+			b = _wyRead8( p + i - 8 );
+		}
+		a ^= WySecret[ 1 ];
+		b ^= seed;
+		_wyMultiply( a, b );
+		return _wyMix( a ^ WySecret[ 0 ] ^ len, b ^ WySecret[ 1 ] );
+	}
+	EON_TEST( substring, fastHash, same,
+		EON_EQ( substring( "abcdefghijklmnopqrstuvwxyz" ).fastHash(), substring( "abcdefghijklmnopqrstuvwxyz" ).fastHash() ) );
+	EON_TEST( substring, fastHash, different,
+		EON_NE( substring( "path/to/item_1" ).fastHash(), substring( "path/to/item_2" ).fastHash() ) );
+	EON_TEST( substring, fastHash, empty,
+		EON_NE( substring( "" ).fastHash(), substring( "a" ).fastHash() ) );
+	EON_TEST( substring, fastHash, seed,
+		EON_NE( substring::fastHash( "abc", "abc" + 3, 0 ), substring::fastHash( "abc", "abc" + 3, 1 ) ) );
+	EON_TEST_2STEP( substring, fastHash, long,
+		std::string source( 1000, 'x' ),
+		EON_NE( substring::fastHash( source.c_str(), source.c_str() + 999 ),
+			substring::fastHash( source.c_str(), source.c_str() + 1000 ) ) );
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include "StringIterator.h"
 #include "Locale.h"
+#include <type_traits>
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -364,6 +365,15 @@ namespace eon
 		static inline uint64_t hash64( const char* begin, const char* end, uint64_t h = FNV_OFFSET64 ) noexcept {
 			for( auto c = begin; c != end; ++c ) { h ^= static_cast<unsigned char>( *c ); h *= FNV_PRIME64; } return h; }
 
+		// Fast hash algorithm (based on wyhash), reading 8 bytes at a time
+		// and mixing using 64x64 to 128 bit multiplication. Significantly
+		// faster than FNV-1a on longer keys, and with better avalanche.
+		// Used for in-memory hashing ('std::hash<eon::string>' etc.).
+		// WARNING: Values may differ between platforms and versions! Use
+		//          [hash32] or [hash64] (FNV-1a) for persisted hash values!
+		inline uint64_t fastHash() const noexcept { return fastHash( Beg.byteData(), End.byteData() ); }
+		static uint64_t fastHash( const char* begin, const char* end, uint64_t seed = 0 ) noexcept;
+
 
 
 
@@ -575,6 +585,9 @@ namespace eon
 			inline int operator()( char_t a, char_t b ) const noexcept {
 				char_t lw_a = Loc->toLower( static_cast<wchar_t>( a ) ), lw_b = Loc->toLower( static_cast<wchar_t>( b ) );
 				return lw_a < lw_b ? -1 : lw_a == lw_b ? 0 : 1; }
+
+			// Get ASCII case folding table for the locale, nullptr if not available.
+			inline const char* asciiFold() const noexcept { return Loc->asciiFold(); }
 		private:
 			const eon::locale* Loc{ nullptr };
 		};
@@ -789,7 +802,10 @@ namespace eon
 		// NOTE: Search is done in 'low-to-high' ordering regardless of current settings!
 		// Returns the found substring ('low-to-high' ordering) within 'this' - ''false' substring if not found.
 		// Comparison is done using a binary char_t predicate.
-		// NOTE: ASCII-only optimization is only done if [eon::substring::FastChrCompare] is used!
+		// NOTE: Byte-level search is done if [eon::substring::fast_chr_compare] is used and both
+		//       'this' and 'to_find' are valid UTF-8 (or 'this' is bytes-only and so is 'to_find').
+		//       The same applies for [eon::substring::icase_chr_compare] if both are bytes-only
+		//       (and the locale folds ASCII case within ASCII).
 		template<typename compare_T = fast_chr_compare>
 		substring findFirst( const substring& to_find, const compare_T& cmp = FastChrCompare ) const noexcept
 		{
@@ -799,8 +815,17 @@ namespace eon
 				return lowToHigh().findFirst( to_find.isHighToLow() ? to_find.lowToHigh() : to_find, cmp );
 			else if( to_find.isHighToLow() )
 				return findFirst( to_find.lowToHigh(), cmp );
-			if( Beg.bytesOnly() && (void*)&cmp == (void*)&FastChrCompare )
-				return _optimizedFindFirst( to_find );
+			if constexpr( std::is_same<compare_T, fast_chr_compare>::value )
+			{
+				if( ( Beg.ValidUTF8 && to_find.Beg.ValidUTF8 )
+					|| ( Beg.bytesOnly() && to_find.numBytes() == to_find.numChars() ) )
+					return _optimizedFindFirst( to_find );
+			}
+			else if constexpr( std::is_same<compare_T, icase_chr_compare>::value )
+			{
+				if( Beg.bytesOnly() && to_find.numBytes() == to_find.numChars() && cmp.asciiFold() != nullptr )
+					return _optimizedFindFirst( to_find, cmp.asciiFold() );
+			}
 			for( string_iterator i = begin(); i != end(); ++i )
 			{
 				string_iterator i_beg = i, j = to_find.begin();
@@ -1305,6 +1330,7 @@ namespace eon
 	private:
 
 		substring _optimizedFindFirst( const substring& to_find ) const noexcept;
+		substring _optimizedFindFirst( const substring& to_find, const char* ascii_fold ) const noexcept;
 		substring _optimizedFindFirst( char_t to_find ) const noexcept;
 		substring _optimizedFindLast( const substring& to_find ) const noexcept;
 		substring _optimizedFindLast( char_t to_find ) const noexcept;
@@ -1313,8 +1339,15 @@ namespace eon
 
 		static inline const char* _findFirst( const char* str, index_t str_size, char c ) noexcept {
 			return (char*)memchr( str, c, str_size ); }
-		const char* _findFirst(
-			const char* source, index_t source_size, const char* substr, index_t substr_size ) const noexcept;
+		static const char* _findFirst(
+			const char* source, index_t source_size, const char* substr, index_t substr_size ) noexcept;
+		static const char* _findFirstHorspool(
+			const char* source, index_t source_size, const char* substr, index_t substr_size ) noexcept;
+		static const char* _findFirst( const char* source, index_t source_size,
+			const char* substr, index_t substr_size, const char* ascii_fold ) noexcept;
+
+		// Get substring for a byte-level match at 'found' within 'this'.
+		substring _foundBytes( const char* found, index_t num_bytes, index_t num_chars ) const noexcept;
 
 		static const char* _findLast( const char* str, index_t str_size, char chr ) noexcept;
 		const char* _findLast(
@@ -516,6 +516,100 @@ namespace eon
 		eon::term << "Std string (" << s_sum << "): " << string::toString( s_ms.count() ) << "ms\n";
 	}
 
+	TEST( String, fast_hash_speed )
+	{
+		// Compare FNV-1a and the fast hash over a range of key lengths
+		size_t total = 64 * 1024 * 1024;
+#ifdef _DEBUG
+		total /= 16;
+#endif
+		std::string source( 4096, ' ' );
+		for( size_t i = 0; i < source.size(); ++i )
+			source[ i ] = static_cast<char>( 'a' + i % 26 );
+
+		std::chrono::steady_clock clock;
+		for( size_t len : { 4, 16, 64, 256, 1024, 4096 } )
+		{
+			size_t rounds = total / len;
+			uint64_t fnv_sum{ 0 }, fast_sum{ 0 };
+			auto fnv_start = clock.now();
+			for( size_t i = 0; i < rounds; ++i )
+				fnv_sum += substring::hash64( source.c_str(), source.c_str() + len, i );
+			auto fnv_end = clock.now();
+			for( size_t i = 0; i < rounds; ++i )
+				fast_sum += substring::fastHash( source.c_str(), source.c_str() + len, i );
+			auto fast_end = clock.now();
+
+			auto fnv_us = std::chrono::duration_cast<std::chrono::microseconds>( fnv_end - fnv_start ).count();
+			auto fast_us = std::chrono::duration_cast<std::chrono::microseconds>( fast_end - fnv_end ).count();
+			auto gbs = [&]( long long us ) {
+				return static_cast<double>( len * rounds ) / ( static_cast<double>( us > 0 ? us : 1 ) * 1000.0 ); };
+			eon::term << string::toString( len ).padLeft( 4 ) << " bytes: FNV-1a " << string::toString( gbs( fnv_us ) )
+				<< " GB/s, fast " << string::toString( gbs( fast_us ) ) << " GB/s\n";
+			WANT_NE( fnv_sum, fast_sum );
+		}
+
+		// Path-like keys must spread well over the low bits used for buckets
+		size_t num_keys = 1 << 16;
+		std::vector<uint8_t> buckets( num_keys, 0 );
+		size_t collisions = 0;
+		for( size_t i = 0; i < num_keys; ++i )
+		{
+			string key = "config/section_" + string( i % 64 ) + "/item_" + string( i / 64 );
+			if( buckets[ key.fastHash() & ( num_keys - 1 ) ]++ > 0 )
+				++collisions;
+		}
+		// Random hashing will have about 1/e (36.8%) collisions
+		eon::term << "Bucket collisions: " << string::toString( collisions ) << " of " << string::toString( num_keys )
+			<< "\n";
+		WANT_TRUE( collisions < num_keys * 4 / 10 );
+	}
+
+	TEST( String, hashed_lookup_speed )
+	{
+		// Look up the same key objects repeatedly in an 'std::unordered_map',
+		// using [eon::string] (hashing every time) and [eon::hashed_string]
+		// (hashing once) as keys.
+		size_t num_keys = 10000, rounds = 200;
+#ifdef _DEBUG
+		rounds /= 10;
+#endif
+		std::vector<string> e_keys;
+		std::vector<hashed_string> h_keys;
+		std::unordered_map<string, size_t> e_map;
+		std::unordered_map<hashed_string, size_t> h_map;
+		for( size_t i = 0; i < num_keys; ++i )
+		{
+			string key = "some/longer/path/to/a/configuration/item/number_" + string( i );
+			e_map[ key ] = i;
+			h_map[ key ] = i;
+			e_keys.push_back( key );
+			h_keys.push_back( std::move( key ) );
+		}
+
+		std::chrono::steady_clock clock;
+		size_t e_sum = 0, h_sum = 0;
+		auto e_start = clock.now();
+		for( size_t i = 0; i < rounds; ++i )
+		{
+			for( auto& key : e_keys )
+				e_sum += e_map.find( key )->second;
+		}
+		auto e_end = clock.now();
+		for( size_t i = 0; i < rounds; ++i )
+		{
+			for( auto& key : h_keys )
+				h_sum += h_map.find( key )->second;
+		}
+		auto h_end = clock.now();
+		REQUIRE_EQ( e_sum, h_sum );
+
+		auto e_ms = std::chrono::duration_cast<std::chrono::milliseconds>( e_end - e_start );
+		auto h_ms = std::chrono::duration_cast<std::chrono::milliseconds>( h_end - e_end );
+		eon::term << "Eon string   : " << string::toString( e_ms.count() ) << "ms\n";
+		eon::term << "Hashed string: " << string::toString( h_ms.count() ) << "ms\n";
+	}
+
 	TEST( String, replace )
 	{
 		WANT_EQ( "elphe bete gemme", eon::string( "alpha beta gamma" ).replace( 'a', 'e' ) ) << "Wrong char";
@@ -540,6 +634,71 @@ namespace eon
 		WANT_EQ( "a but b not c", eon::string( "a and b or c" ).replace( { { "or", "not" }, { "and", "but" } } ) );
 		WANT_EQ( "x,y.z", eon::string( "a,b.c" ).replace( { { 'a', 'x' }, { 'b', 'y' }, { 'c', 'z' } } ) );
 	}
+	TEST( String, replace_multipattern )
+	{
+		multipattern patterns( std::map<string, string>{ { "${name}", "World" }, { "${greeting}", "Hello" },
+			{ "${greeting_long}", "Good day" } } );
+		WANT_EQ( "Hello World!", eon::string( "${greeting} ${name}!" ).replace( patterns ) );
+		WANT_EQ( "Good day World, Hello!", eon::string( "${greeting_long} ${name}, ${greeting}!" ).replace( patterns ) );
+		WANT_EQ( "${nam} World", eon::string( "${nam} ${name}" ).replace( patterns ) );
+		eon::string str{ "${name} ${name} ${name}" };
+		WANT_EQ( "${name} World ${name}", str.replace( patterns, str.substr( str.begin() + 1, str.end() - 1 ) ) );
+	}
+	TEST( String, replace_multipattern_speed )
+	{
+		// Compare replacing 256 placeholders in a document by trying each map
+		// key at each position (as done before) against [eon::multipattern].
+		std::map<string, string> find_replace;
+		for( int i = 0; i < 256; ++i )
+			find_replace[ "${placeholder_" + string( i ) + "}" ] = "value number " + string( i );
+		std::string doc;
+		for( int i = 0; doc.size() < 256 * 1024; ++i )
+			doc += "Some text with a ${placeholder_" + std::to_string( ( i * 7 ) % 300 ) + "} in it, and more text. ";
+		string source( doc );
+
+		auto naive = [&]() -> string {
+			string output;
+			for( auto i = source.begin(); i != source.end(); ++i )
+			{
+				bool replaced = false;
+				for( auto& elm : find_replace )
+				{
+					if( source.substr( i, source.end() ).compareSub( elm.first.substr(), elm.first.numChars() ) == 0 )
+					{
+						output += elm.second;
+						i += elm.first.numChars() - 1;
+						replaced = true;
+						break;
+					}
+				}
+				if( !replaced )
+					output += *i;
+			}
+			return output;
+		};
+
+		std::chrono::steady_clock clock;
+		auto naive_start = clock.now();
+		auto naive_result = naive();
+		auto naive_end = clock.now();
+		multipattern patterns( find_replace );
+		auto compiled_end = clock.now();
+		size_t rounds = 20;
+		string result;
+		for( size_t i = 0; i < rounds; ++i )
+			result = source.replace( patterns );
+		auto multi_end = clock.now();
+		REQUIRE_EQ( naive_result, result );
+		REQUIRE_EQ( naive_result.numChars(), result.numChars() );
+
+		auto us = []( std::chrono::steady_clock::duration dur ) {
+			return std::chrono::duration_cast<std::chrono::microseconds>( dur ).count(); };
+		eon::term << "Naive       : " << string::toString( us( naive_end - naive_start ) ) << " us\n";
+		eon::term << "Compile     : " << string::toString( us( compiled_end - naive_end ) ) << " us ("
+			<< string::toString( patterns.numStates() ) << " states)\n";
+		eon::term << "Multipattern: " << string::toString( us( multi_end - compiled_end ) / static_cast<long long>( rounds ) )
+			<< " us\n";
+	}
 	TEST( String, replace_speed )
 	{
 		eon::string base{ "one one-thousand two one-thousand three one-thousand four one-thousand five one-thousand size one-"
@@ -889,6 +1048,167 @@ namespace eon
 		eon::term << "Std string (" << s_sum << "): " << string::toString( s_ms.count() ) << "ms\n";
 	}
 
+	TEST( String, utf8_speed )
+	{
+		// Compare validating and counting UTF-8 one byte at a time (as done
+		// before vectorization) against [eon::string_iterator::scanUtf8], for
+		// ASCII-only and for mixed input.
+		size_t size = 16 * 1024 * 1024, rounds = 10;
+#ifdef _DEBUG
+		rounds = 1;
+#endif
+		std::string ascii, mixed;
+		ascii.reserve( size ); mixed.reserve( size );
+		while( ascii.size() < size )
+		{
+			ascii += "The quick brown fox jumps over the lazy dog, again and again and again. ";
+			mixed += u8"Blåbærsyltetøy på brød, 3€ stykket ™ with some plain words inbetween. ";
+		}
+
+		auto byte_by_byte = []( const std::string& str ) -> index_t {
+			char32_t state{ 0 }, cp{ 0 };
+			index_t num = 0;
+			for( auto c : str )
+			{
+				if( !string_iterator::utf8Decode( state, cp, static_cast<unsigned char>( c ) ) )
+					++num;
+			}
+			return state == UTF8_ACCEPT ? num : 0;
+		};
+		auto scan = []( const std::string& str ) -> index_t {
+			index_t num = 0;
+			return string_iterator::scanUtf8( str.c_str(), str.c_str() + str.size(), num ) ? num : 0;
+		};
+
+		std::chrono::steady_clock clock;
+		for( auto input : { &ascii, &mixed } )
+		{
+			index_t old_num = 0, new_num = 0;
+			auto old_start = clock.now();
+			for( size_t i = 0; i < rounds; ++i )
+				old_num = byte_by_byte( *input );
+			auto old_end = clock.now();
+			for( size_t i = 0; i < rounds; ++i )
+				new_num = scan( *input );
+			auto new_end = clock.now();
+			REQUIRE_EQ( old_num, new_num );
+
+			auto old_us = std::chrono::duration_cast<std::chrono::microseconds>( old_end - old_start ).count();
+			auto new_us = std::chrono::duration_cast<std::chrono::microseconds>( new_end - old_end ).count();
+			auto gbs = [&]( long long us ) {
+				return static_cast<double>( input->size() * rounds ) / ( static_cast<double>( us > 0 ? us : 1 ) * 1000.0 ); };
+			eon::term << ( input == &ascii ? "ASCII" : "Mixed" ) << " input:\n";
+			eon::term << "  Byte by byte: " << string::toString( gbs( old_us ) ) << " GB/s\n";
+			eon::term << "  Scan        : " << string::toString( gbs( new_us ) ) << " GB/s\n";
+		}
+	}
+
+	TEST( String, findFirst_speed )
+	{
+		// Compare searching a 1 MB source character by character (forced by
+		// using a predicate other than [eon::substring::fast_chr_compare])
+		// against the byte-level search, for ASCII and mixed UTF-8 sources.
+		size_t size = 1024 * 1024, rounds = 20;
+#ifdef _DEBUG
+		rounds = 2;
+#endif
+		std::string ascii, mixed;
+		while( ascii.size() < size )
+		{
+			ascii += "The quick brown fox jumps over the lazy dog, again and again and again. ";
+			mixed += u8"Blåbærsyltetøy på brød, 3€ stykket ™ with some plain words inbetween. ";
+		}
+		ascii += "needle in a haystack";
+		mixed += u8"nål i en høystakk";
+		struct slow_chr_compare {
+			inline int operator()( char_t a, char_t b ) const noexcept { return a < b ? -1 : a == b ? 0 : 1; } };
+		slow_chr_compare slow;
+
+		std::chrono::steady_clock clock;
+		for( auto input : { &ascii, &mixed } )
+		{
+			string source( *input );
+			string to_find = input == &ascii ? string( "needle in a" ) : string( u8"nål i en" );
+			substring old_found, new_found, icase_found;
+			auto old_start = clock.now();
+			for( size_t i = 0; i < rounds; ++i )
+				old_found = source.substr().findFirst( to_find.substr(), slow );
+			auto old_end = clock.now();
+			for( size_t i = 0; i < rounds; ++i )
+				new_found = source.substr().findFirst( to_find.substr() );
+			auto new_end = clock.now();
+			// Case insensitive byte-level search is for ASCII only
+			auto upper = to_find.upper();
+			for( size_t i = 0; input == &ascii && i < rounds; ++i )
+				icase_found = source.substr().findFirst( upper.substr(), substring::ICaseChrCompare );
+			auto icase_end = clock.now();
+			REQUIRE_TRUE( old_found );
+			REQUIRE_TRUE( old_found.begin() == new_found.begin() && old_found.end() == new_found.end() );
+			if( input == &ascii )
+				WANT_TRUE( old_found.begin() == icase_found.begin() );
+
+			auto gbs = [&]( std::chrono::steady_clock::duration dur ) {
+				auto us = std::chrono::duration_cast<std::chrono::microseconds>( dur ).count();
+				return static_cast<double>( input->size() * rounds ) / ( static_cast<double>( us > 0 ? us : 1 ) * 1000.0 ); };
+			eon::term << ( input == &ascii ? "ASCII" : "Mixed" ) << " source:\n";
+			eon::term << "  Char by char: " << string::toString( gbs( old_end - old_start ) ) << " GB/s\n";
+			eon::term << "  Byte search : " << string::toString( gbs( new_end - old_end ) ) << " GB/s\n";
+			if( input == &ascii )
+				eon::term << "  Ignore case : " << string::toString( gbs( icase_end - new_end ) ) << " GB/s\n";
+		}
+	}
+
+	TEST( String, char_index_speed )
+	{
+		// Compare random access by character position in a 10 MB UTF-8
+		// string: stepping character by character, skipping by
+		// [eon::string_iterator::operator+=], and using the character index.
+		std::string bytes;
+		while( bytes.size() < 10 * 1024 * 1024 )
+			bytes += u8"Blåbærsyltetøy på brød, 3€ stykket ™ with some plain words inbetween. ";
+		string source( std::move( bytes ) );
+		size_t slow_rounds = 10, fast_rounds = 100, indexed_rounds = 100000;
+#ifdef _DEBUG
+		slow_rounds = 2; fast_rounds = 10; indexed_rounds = 10000;
+#endif
+		auto position = [&]( size_t round ) { return static_cast<index_t>( ( round * 2654435761u ) % source.numChars() ); };
+
+		std::chrono::steady_clock clock;
+		char_t slow_sum = 0, fast_sum = 0, indexed_sum = 0;
+		auto slow_start = clock.now();
+		for( size_t i = 0; i < slow_rounds; ++i )
+		{
+			auto pos = source.begin();
+			for( index_t j = position( i ); j > 0; --j, ++pos );
+			slow_sum += *pos;
+		}
+		auto fast_start = clock.now();
+		for( size_t i = 0; i < fast_rounds; ++i )
+			fast_sum += *( source.begin() + position( i ) );
+		auto indexed_start = clock.now();
+		for( size_t i = 0; i < indexed_rounds; ++i )
+			indexed_sum += source.at( position( i ) );
+		auto indexed_end = clock.now();
+
+		auto check_sum = [&]( size_t rounds ) {
+			char_t sum = 0; for( size_t i = 0; i < rounds; ++i ) sum += source.at( position( i ) ); return sum; };
+		REQUIRE_EQ( slow_sum, check_sum( slow_rounds ) );
+		REQUIRE_EQ( fast_sum, check_sum( fast_rounds ) );
+		WANT_EQ( source.substr( 1000000, 5 ), substring( source.begin() + 1000000, source.begin() + 1000005 ) );
+
+		auto us_per_lookup = [&]( std::chrono::steady_clock::duration dur, size_t rounds ) {
+			auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>( dur ).count();
+			return static_cast<double>( ns ) / ( static_cast<double>( rounds ) * 1000.0 ); };
+		eon::term << "Random access in " << string::toString( source.numChars() ) << " characters:\n";
+		eon::term << "  Char by char: " << string::toString( us_per_lookup( fast_start - slow_start, slow_rounds ) )
+			<< " us/lookup\n";
+		eon::term << "  Skip bytes  : " << string::toString( us_per_lookup( indexed_start - fast_start, fast_rounds ) )
+			<< " us/lookup\n";
+		eon::term << "  Char index  : " << string::toString(
+			us_per_lookup( indexed_end - indexed_start, indexed_rounds ) ) << " us/lookup\n";
+		WANT_TRUE( indexed_sum != 0 );
+	}
+
 
 
 	struct name_tt
@@ -904,6 +1224,32 @@ namespace eon
 		WANT_EQ( n1, n2 );
 		WANT_EQ( "name", str( n2 ) );
 	}
+	TEST( Name, defaults )
+	{
+		static_assert( name_bool != name_int, "Default names must be compile-time constants" );
+		auto type = [&]( const name_t& value ) -> int {
+			switch( value )
+			{
+				case name_bool:
+					return 1;
+				case name_int:
+					return 2;
+				case name_nn:
+					return 3;
+				default:
+					return 0;
+			}
+		};
+		WANT_EQ( 1, type( name( "bool" ) ) );
+		WANT_EQ( 2, type( name( "int" ) ) );
+		WANT_EQ( 3, type( compilerName( "$NN" ) ) );
+		WANT_EQ( 0, type( name( "float" ) ) );
+		for( uint32_t id = 1; id <= defaultname::count; ++id )
+		{
+			REQUIRE_EQ( defaultname::strings[ id - 1 ], str( name_t( id ) ) );
+			WANT_EQ( name_t( id ), compilerName( defaultname::strings[ id - 1 ] ) );
+		}
+	}
 	TEST( Name, compiler )
 	{
 		auto n1 = compilerName( "$name" );
@@ -930,6 +1276,72 @@ namespace eon
 		WANT_EQ( "three", str( ref.at( 2 ) ) );
 	}
 
+	TEST( Name, contention )
+	{
+		size_t num_threads = std::max( std::thread::hardware_concurrency(), 4u );
+		size_t num_names = 20000, rounds = 20;
+#ifdef _DEBUG
+		num_names /= 10;
+#endif
+		std::vector<string> names;
+		for( size_t i = 0; i < num_names; ++i )
+			names.push_back( "contention_" + string( i ) );
+
+		std::chrono::steady_clock clock;
+		std::atomic<size_t> failures{ 0 };
+		auto start = clock.now();
+		std::vector<std::thread> threads;
+		for( size_t t = 0; t < num_threads; ++t )
+		{
+			threads.push_back( std::thread( [&names, &failures, rounds, t]()
+				{
+					for( size_t round = 0; round < rounds; ++round )
+					{
+						// Interleave threads so that some intern while others look up
+						for( size_t i = 0; i < names.size(); ++i )
+						{
+							auto& value = names[ ( i + t * 997 ) % names.size() ];
+							if( eon::str( eon::name( value ) ) != value )
+								++failures;
+						}
+					}
+				} ) );
+		}
+		for( auto& thread : threads )
+			thread.join();
+		auto end = clock.now();
+
+		auto ms = std::chrono::duration_cast<std::chrono::milliseconds>( end - start );
+		eon::term << string::toString( num_threads ) << " threads, " << string::toString( num_threads * rounds * num_names )
+			<< " name+str lookups: " << string::toString( ms.count() ) << "ms\n";
+		WANT_EQ( 0, failures.load() );
+	}
+	TEST( Name, stats )
+	{
+		size_t num_names = 500000;
+#ifdef _DEBUG
+		num_names /= 100;
+#endif
+		auto before = nameStats();
+		std::chrono::steady_clock clock;
+		auto start = clock.now();
+		for( size_t i = 0; i < num_names; ++i )
+			name( "identifier_" + string( i ) );
+		auto end = clock.now();
+		auto after = nameStats();
+
+		auto ms = std::chrono::duration_cast<std::chrono::milliseconds>( end - start );
+		eon::term << "Interned " << string::toString( after.Count - before.Count ) << " names in "
+			<< string::toString( ms.count() ) << "ms\n";
+		eon::term << "  name bytes : " << string::toString( after.Bytes ).separateThousands() << "\n";
+		eon::term << "  arena bytes: " << string::toString( after.ArenaBytes ).separateThousands() << "\n";
+		eon::term << "  heap bytes : " << string::toString( after.HeapBytes ).separateThousands() << "\n";
+		eon::term << "  index bytes: " << string::toString( after.IndexBytes ).separateThousands() << "\n";
+		eon::term << "  load factor: " << string::toString( after.LoadFactor ) << "\n";
+		WANT_EQ( before.Count + num_names, after.Count );
+		WANT_TRUE( after.LoadFactor > 0.0 && after.LoadFactor <= 0.7 );
+	}
+
 
 
 	TEST( HexTest, toHex )
@@ -2,11 +2,16 @@
 
 #include <eontest/Test.h>
 #include <eonstring/String.h>
+#include <eonstring/HashedString.h>
+#include <eonstring/MultiPattern.h>
 #include <eonstring/Name.h>
 #include <eonstring/NamePath.h>
 #include <eonstring/Hex.h>
 #include <eonstring/ByteSerializer.h>
 #include <eonstring/Stringifier.h>
+#include <thread>
+#include <atomic>
+#include <chrono>
 
 
 namespace eon
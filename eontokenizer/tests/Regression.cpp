@@ -1,4 +1,5 @@
 #include "Regression.h"
+#include <fstream>
 
 
 
@@ -233,4 +234,68 @@ namespace eon
 		string actual = fullJoin( tokens );
 		WANT_EQ( expected, actual );
 	}
-}
+
+
+	// Common function used by speed tests, writes a source file of
+	// (approximately) the specified size and returns its path
+	std::string SpeedCmp::prepareSourceFile( size_t size )
+	{
+#ifdef EON_WINDOWS
+		std::string file = std::string( getenv( "TMP" ) ) + "/eon_tokenizer_speed.txt";
+#else
+		std::string file = "/tmp/eon_tokenizer_speed.txt";
+#endif
+		std::string line{ "name_1 += 2.5 * (value - 12) # \"some text\" [x, y, z]\n" };
+		std::ofstream output( file, std::ios_base::out | std::ios_base::binary );
+		for( size_t written = 0; written < size; written += line.size() )
+			output.write( line.c_str(), line.size() );
+		return file;
+	}
+
+	// Common function used by speed tests, tokenizes the same file through
+	// stream (optional) and memory mapped sources
+	void SpeedCmp::compareFileSources( size_t size, bool include_stream )
+	{
+		auto file = prepareSourceFile( size );
+		std::chrono::steady_clock clock;
+		size_t stream_tokens{ 0 };
+		if( include_stream )
+		{
+			source::File stream_src( file );
+			auto start = clock.now();
+			stream_tokens = Tok( stream_src ).size();
+			auto ms = std::chrono::duration_cast<std::chrono::milliseconds>( clock.now() - start );
+			eon::term << "Stream source (" << string::toString( stream_tokens ) << " tokens): "
+				<< string::toString( ms.count() ) << "ms\n";
+		}
+
+		source::MappedFile mapped_src( file );
+		auto start = clock.now();
+		auto mapped_tokens = Tok( mapped_src ).size();
+		auto ms = std::chrono::duration_cast<std::chrono::milliseconds>( clock.now() - start );
+		eon::term << "Mapped source (" << string::toString( mapped_tokens ) << " tokens): "
+			<< string::toString( ms.count() ) << "ms\n";
+		if( include_stream )
+			WANT_EQ( stream_tokens, mapped_tokens );
+	}
+
+	TEST( SpeedCmp, file_mapped_1mb )
+	{
+		size_t size = 1024 * 1024;
+#ifdef _DEBUG
+		size /= 10;
+#endif
+		compareFileSources( size );
+	}
+#ifdef EON_TEST_LARGE
+	TEST( SpeedCmp, file_mapped_100mb )
+	{
+		// Stream source is way too slow for this size!
+		size_t size = 100 * 1024 * 1024;
+#ifdef _DEBUG
+		size /= 100;
+#endif
+		compareFileSources( size, false );
+	}
+#endif
+}
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include <eontokenizer/ReTokenizer.h>
 #include <eontokenizer/TokenMatcher.h>
 #include <eonsource/String.h>
+#include <eonsource/File.h>
+#include <eonsource/MappedFile.h>
+#include <chrono>
 
 
 namespace eon
@@ -57,5 +60,11 @@ namespace eon
 		}
 	};
 	class TokenParserTest : public TokenizerTest {};
+	class SpeedCmp : public TokenizerTest
+	{
+	public:
+		std::string prepareSourceFile( size_t size );
+		void compareFileSources( size_t size, bool include_stream = true );
+	};
 	class ReTokenizerTest : public TokenizerTest {};
 }